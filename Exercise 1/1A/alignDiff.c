@@ -0,0 +1,552 @@
+/**
+ * @file alignDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the aligned comparison of two files.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "alignDiff.h"
+#include "diffKernel.h"
+
+/**
+ * @brief Data structure to store one line of a file
+ */
+struct alignLine
+{
+    const char *data;
+    size_t length;
+    uint64_t hash;
+};
+
+/**
+ * @brief Data structure to store the state of the alignment
+ * @details Lines without an equal line in the other file are discarded before the alignment,
+ * lines1/lines2 only contain the remaining lines and indices1/indices2 their original indices.
+ * forward and backward are the furthest reaching x-positions of the diagonals (x - y) and are
+ * indexed with the diagonal + count2 + 1. changed1/changed2 mark the original lines, which are
+ * not part of the alignment.
+ */
+struct alignDiff
+{
+    struct alignLine *lines1;
+    struct alignLine *lines2;
+    long count1;
+    long count2;
+    long *indices1;
+    long *indices2;
+    diffKernel kernel;
+    long *forward;
+    long *backward;
+    bool *changed1;
+    bool *changed2;
+    long tooExpensive;
+};
+
+/**
+ * @brief Data structure to store the point, where the middle snake splits the sequences
+ */
+struct partition
+{
+    long x;
+    long y;
+};
+
+/**
+ * @brief Reads all lines of the file and calculates their hashes
+ *
+ * @param lineReader Pointer to the line-reader of the file
+ * @param isCaseInsensitive Flag if the hashes should ignore the letter case
+ * @param lines Pointer which will be set to the allocated array of lines
+ * @param count Pointer which will be set to the amount of lines
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int readLines(struct lineReader *lineReader, bool isCaseInsensitive, struct alignLine **lines, long *count)
+{
+    const char *data;
+    size_t length;
+    if (readRemaining(lineReader, &data, &length) == -1)
+        return -1;
+
+    // a last line without linebreak counts as line too
+    size_t lineCount = countLinebreaks(data, length);
+    if (length > 0 && data[length - 1] != '\n')
+        lineCount++;
+
+    if (lineCount > LONG_MAX / 2 || (*lines = malloc((lineCount + 1) * sizeof(struct alignLine))) == NULL)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    struct lineReader memoryReader;
+    initMemoryLineReader(&memoryReader, data, length);
+
+    long i = 0;
+    const char *line;
+    size_t lineLength;
+    while (readLine(&memoryReader, &line, &lineLength) == 1)
+    {
+        (*lines)[i].data = line;
+        (*lines)[i].length = lineLength;
+        (*lines)[i].hash = (isCaseInsensitive == true) ? hashLineCaseInsensitive(line, lineLength) : hashLine(line, lineLength);
+        i++;
+    }
+
+    *count = i;
+
+    return 0;
+}
+
+/**
+ * @brief Returns true, if the line x of the first file is equal to the line y of the second file
+ *
+ * @param diff Pointer to the state of the alignment
+ * @param x Index of the line of the first file
+ * @param y Index of the line of the second file
+ * @return true if the lines are equal, otherwise false
+ */
+static bool isEqual(const struct alignDiff *diff, long x, long y)
+{
+    const struct alignLine *line1 = &diff->lines1[x], *line2 = &diff->lines2[y];
+
+    return line1->hash == line2->hash && line1->length == line2->length && diff->kernel(line1->data, line2->data, line1->length) == 0;
+}
+
+/**
+ * @brief Searches the best diagonals of the forward and backward search, if the middle snake is
+ * too expensive, and splits the sequences at the one which reached further
+ *
+ * @param diff Pointer to the state of the alignment
+ * @param xOffset Start of the range of the first file
+ * @param xLimit End of the range of the first file
+ * @param yOffset Start of the range of the second file
+ * @param yLimit End of the range of the second file
+ * @param forwardMin Smallest diagonal of the forward search
+ * @param forwardMax Largest diagonal of the forward search
+ * @param backwardMin Smallest diagonal of the backward search
+ * @param backwardMax Largest diagonal of the backward search
+ * @param partition Pointer to the partition, which is set by this function
+ */
+static void splitAtBestDiagonal(const struct alignDiff *diff, long xOffset, long xLimit, long yOffset, long yLimit,
+                                long forwardMin, long forwardMax, long backwardMin, long backwardMax, struct partition *partition)
+{
+    const long *forward = diff->forward, *backward = diff->backward;
+
+    long forwardBest = -1, forwardBestX = xOffset;
+    for (long d = forwardMax; d >= forwardMin; d -= 2)
+    {
+        long x = (forward[d] < xLimit) ? forward[d] : xLimit, y = x - d;
+        if (yLimit < y)
+        {
+            x = yLimit + d;
+            y = yLimit;
+        }
+        if (forwardBest < x + y)
+        {
+            forwardBest = x + y;
+            forwardBestX = x;
+        }
+    }
+
+    long backwardBest = LONG_MAX, backwardBestX = xLimit;
+    for (long d = backwardMax; d >= backwardMin; d -= 2)
+    {
+        long x = (xOffset < backward[d]) ? backward[d] : xOffset, y = x - d;
+        if (y < yOffset)
+        {
+            x = yOffset + d;
+            y = yOffset;
+        }
+        if (x + y < backwardBest)
+        {
+            backwardBest = x + y;
+            backwardBestX = x;
+        }
+    }
+
+    if ((xLimit + yLimit) - backwardBest < forwardBest - (xOffset + yOffset))
+    {
+        partition->x = forwardBestX;
+        partition->y = forwardBest - forwardBestX;
+    }
+    else
+    {
+        partition->x = backwardBestX;
+        partition->y = backwardBest - backwardBestX;
+    }
+}
+
+/**
+ * @brief Finds the middle snake of the shortest edit script of both ranges. The forward search starts
+ * at the top left and the backward search at the bottom right, until both searches overlap.
+ * @details Both ranges have to be non-empty and their first and last lines have to differ.
+ *
+ * @param diff Pointer to the state of the alignment
+ * @param xOffset Start of the range of the first file
+ * @param xLimit End of the range of the first file
+ * @param yOffset Start of the range of the second file
+ * @param yLimit End of the range of the second file
+ * @param partition Pointer to the partition, which is set by this function
+ */
+static void findMiddleSnake(const struct alignDiff *diff, long xOffset, long xLimit, long yOffset, long yLimit, struct partition *partition)
+{
+    long *forward = diff->forward, *backward = diff->backward;
+    long diagonalMin = xOffset - yLimit, diagonalMax = xLimit - yOffset;
+    long forwardMiddle = xOffset - yOffset, backwardMiddle = xLimit - yLimit;
+    long forwardMin = forwardMiddle, forwardMax = forwardMiddle;
+    long backwardMin = backwardMiddle, backwardMax = backwardMiddle;
+    bool isOdd = ((forwardMiddle - backwardMiddle) & 1) != 0;
+
+    forward[forwardMiddle] = xOffset;
+    backward[backwardMiddle] = xLimit;
+
+    for (long cost = 1;; cost++)
+    {
+        // extend the forward search by one edit
+        if (forwardMin > diagonalMin)
+            forward[--forwardMin - 1] = -1;
+        else
+            forwardMin++;
+        if (forwardMax < diagonalMax)
+            forward[++forwardMax + 1] = -1;
+        else
+            forwardMax--;
+
+        for (long d = forwardMax; d >= forwardMin; d -= 2)
+        {
+            long low = forward[d - 1], high = forward[d + 1];
+            long x = (low < high) ? high : low + 1, y = x - d;
+            while (x < xLimit && y < yLimit && isEqual(diff, x, y) == true)
+            {
+                x++;
+                y++;
+            }
+            forward[d] = x;
+
+            if (isOdd == true && backwardMin <= d && d <= backwardMax && backward[d] <= x)
+            {
+                partition->x = x;
+                partition->y = y;
+                return;
+            }
+        }
+
+        // extend the backward search by one edit
+        if (backwardMin > diagonalMin)
+            backward[--backwardMin - 1] = LONG_MAX;
+        else
+            backwardMin++;
+        if (backwardMax < diagonalMax)
+            backward[++backwardMax + 1] = LONG_MAX;
+        else
+            backwardMax--;
+
+        for (long d = backwardMax; d >= backwardMin; d -= 2)
+        {
+            long low = backward[d - 1], high = backward[d + 1];
+            long x = (low < high) ? low : high - 1, y = x - d;
+            while (xOffset < x && yOffset < y && isEqual(diff, x - 1, y - 1) == true)
+            {
+                x--;
+                y--;
+            }
+            backward[d] = x;
+
+            if (isOdd == false && forwardMin <= d && d <= forwardMax && x <= forward[d])
+            {
+                partition->x = x;
+                partition->y = y;
+                return;
+            }
+        }
+
+        if (cost >= diff->tooExpensive)
+        {
+            splitAtBestDiagonal(diff, xOffset, xLimit, yOffset, yLimit, forwardMin, forwardMax, backwardMin, backwardMax, partition);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Aligns the ranges of both files recursively and marks the lines, which are not aligned
+ *
+ * @param diff Pointer to the state of the alignment
+ * @param xOffset Start of the range of the first file
+ * @param xLimit End of the range of the first file
+ * @param yOffset Start of the range of the second file
+ * @param yLimit End of the range of the second file
+ */
+static void compareSequences(struct alignDiff *diff, long xOffset, long xLimit, long yOffset, long yLimit)
+{
+    // equal lines at the start and the end are always aligned
+    while (xOffset < xLimit && yOffset < yLimit && isEqual(diff, xOffset, yOffset) == true)
+    {
+        xOffset++;
+        yOffset++;
+    }
+    while (xOffset < xLimit && yOffset < yLimit && isEqual(diff, xLimit - 1, yLimit - 1) == true)
+    {
+        xLimit--;
+        yLimit--;
+    }
+
+    if (xOffset == xLimit)
+    {
+        while (yOffset < yLimit)
+            diff->changed2[diff->indices2[yOffset++]] = true;
+    }
+    else if (yOffset == yLimit)
+    {
+        while (xOffset < xLimit)
+            diff->changed1[diff->indices1[xOffset++]] = true;
+    }
+    else
+    {
+        struct partition partition;
+        findMiddleSnake(diff, xOffset, xLimit, yOffset, yLimit, &partition);
+        compareSequences(diff, xOffset, partition.x, yOffset, partition.y);
+        compareSequences(diff, partition.x, xLimit, partition.y, yLimit);
+    }
+}
+
+/**
+ * @brief Builds a hash-set (open addressing) of the hashes of all lines
+ * @details The empty slots are 0, so the hash 0 is stored as 1.
+ *
+ * @param lines Array of the lines
+ * @param count Amount of lines
+ * @param mask Pointer which will be set to the size of the hash-set minus 1
+ * @return The allocated hash-set or NULL if the allocation failed
+ */
+static uint64_t *buildHashSet(const struct alignLine *lines, long count, size_t *mask)
+{
+    size_t size = 16;
+    while (size < (size_t)count * 2)
+        size *= 2;
+
+    uint64_t *hashSet = calloc(size, sizeof(uint64_t));
+    if (hashSet == NULL)
+        return NULL;
+
+    for (long i = 0; i < count; i++)
+    {
+        uint64_t hash = (lines[i].hash == 0) ? 1 : lines[i].hash;
+        size_t slot = hash & (size - 1);
+        while (hashSet[slot] != 0 && hashSet[slot] != hash)
+            slot = (slot + 1) & (size - 1);
+        hashSet[slot] = hash;
+    }
+
+    *mask = size - 1;
+
+    return hashSet;
+}
+
+/**
+ * @brief Returns true, if the hash-set contains the hash
+ *
+ * @param hashSet The hash-set
+ * @param mask The size of the hash-set minus 1
+ * @param hash The hash which should be searched
+ * @return true if the hash is contained, otherwise false
+ */
+static bool containsHash(const uint64_t *hashSet, size_t mask, uint64_t hash)
+{
+    if (hash == 0)
+        hash = 1;
+
+    for (size_t slot = hash & mask; hashSet[slot] != 0; slot = (slot + 1) & mask)
+    {
+        if (hashSet[slot] == hash)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Discards the lines, which have no line with the same hash in the other file. Those lines
+ * can never be aligned, so they are marked as changed and the remaining lines are moved to the
+ * front of the array. Without them the edit script of very different files gets much shorter.
+ *
+ * @param lines Array of the lines, which is compacted
+ * @param count Pointer to the amount of lines, which is set to the amount of remaining lines
+ * @param otherLines Array of the lines of the other file
+ * @param otherCount Amount of lines of the other file
+ * @param changed Array of the changed-flags of the original lines
+ * @param indices Array, which gets the original indices of the remaining lines
+ * @return 0 on success and -1 if the allocation failed
+ */
+static int discardUnmatchedLines(struct alignLine *lines, long *count, const struct alignLine *otherLines, long otherCount, bool *changed, long *indices)
+{
+    size_t mask;
+    uint64_t *hashSet = buildHashSet(otherLines, otherCount, &mask);
+    if (hashSet == NULL)
+        return -1;
+
+    long remaining = 0;
+    for (long i = 0; i < *count; i++)
+    {
+        if (containsHash(hashSet, mask, lines[i].hash) == false)
+        {
+            changed[i] = true;
+            continue;
+        }
+
+        lines[remaining] = lines[i];
+        indices[remaining++] = i;
+    }
+
+    *count = remaining;
+    free(hashSet);
+
+    return 0;
+}
+
+/**
+ * @brief Writes the changed, deleted and inserted lines of the alignment. Within a block of
+ * changed lines, the lines are paired in their order.
+ *
+ * @param diff Pointer to the state of the alignment
+ * @param lines1 Array of all lines of the first file
+ * @param count1 Amount of lines of the first file
+ * @param lines2 Array of all lines of the second file
+ * @param count2 Amount of lines of the second file
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param isCaseInsensitive Flag if the edit distance should ignore the letter case
+ * @return The amount of written records or -1 if an error occured (errno is set)
+ */
+static int64_t writeAlignment(const struct alignDiff *diff, const struct alignLine *lines1, long count1, const struct alignLine *lines2, long count2,
+                              struct outputSink *outputSink, bool isCaseInsensitive)
+{
+    int64_t records = 0;
+    long x = 0, y = 0;
+
+    while (x < count1 || y < count2)
+    {
+        if (x < count1 && y < count2 && diff->changed1[x] == false && diff->changed2[y] == false)
+        {
+            x++;
+            y++;
+            continue;
+        }
+
+        long xStart = x, yStart = y;
+        while (x < count1 && diff->changed1[x] == true)
+            x++;
+        while (y < count2 && diff->changed2[y] == true)
+            y++;
+
+        for (long i = 0; xStart + i < x || yStart + i < y; i++)
+        {
+            const struct alignLine *line1 = (xStart + i < x) ? &lines1[xStart + i] : NULL;
+            const struct alignLine *line2 = (yStart + i < y) ? &lines2[yStart + i] : NULL;
+
+            size_t characters;
+            if (line1 != NULL && line2 != NULL)
+                characters = editDistance(line1->data, line1->length, line2->data, line2->length, isCaseInsensitive);
+            else
+                characters = (line1 != NULL) ? line1->length : line2->length;
+
+            if (characters == SIZE_MAX)
+            {
+                errno = ENOMEM;
+                return -1;
+            }
+
+            // lines which only differ in their letter case can be changed lines too
+            if (characters == 0 && line1 != NULL && line2 != NULL)
+                continue;
+
+            if (writeAlignedDifference(outputSink, (line1 != NULL) ? xStart + i + 1 : 0, (line2 != NULL) ? yStart + i + 1 : 0, characters) == -1)
+                return -1;
+            records++;
+        }
+    }
+
+    return records;
+}
+
+int64_t compareFilesAligned(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, bool isCaseInsensitive)
+{
+    struct alignLine *lines1, *lines2;
+    long count1, count2;
+
+    if (readLines(lineReader1, isCaseInsensitive, &lines1, &count1) == -1)
+        return -1;
+    if (readLines(lineReader2, isCaseInsensitive, &lines2, &count2) == -1)
+    {
+        free(lines1);
+        return -1;
+    }
+
+    struct alignDiff diff = {.count1 = count1, .count2 = count2, .kernel = selectDiffKernel(isCaseInsensitive)};
+    diff.lines1 = malloc((count1 + 1) * sizeof(struct alignLine));
+    diff.lines2 = malloc((count2 + 1) * sizeof(struct alignLine));
+    diff.indices1 = malloc((count1 + 1) * sizeof(long));
+    diff.indices2 = malloc((count2 + 1) * sizeof(long));
+    diff.changed1 = calloc(count1 + 1, sizeof(bool));
+    diff.changed2 = calloc(count2 + 1, sizeof(bool));
+
+    long diagonals = count1 + count2 + 3;
+    diff.forward = malloc(diagonals * sizeof(long));
+    diff.backward = malloc(diagonals * sizeof(long));
+
+    int64_t records = -1;
+    if (diff.lines1 == NULL || diff.lines2 == NULL || diff.indices1 == NULL || diff.indices2 == NULL ||
+        diff.changed1 == NULL || diff.changed2 == NULL || diff.forward == NULL || diff.backward == NULL)
+    {
+        errno = ENOMEM;
+    }
+    else
+    {
+        memcpy(diff.lines1, lines1, count1 * sizeof(struct alignLine));
+        memcpy(diff.lines2, lines2, count2 * sizeof(struct alignLine));
+
+        if (discardUnmatchedLines(diff.lines1, &diff.count1, lines2, count2, diff.changed1, diff.indices1) == -1 ||
+            discardUnmatchedLines(diff.lines2, &diff.count2, lines1, count1, diff.changed2, diff.indices2) == -1)
+        {
+            errno = ENOMEM;
+        }
+        else
+        {
+            // the diagonals range from -(count2 + 1) to count1 + 1
+            long *forward = diff.forward, *backward = diff.backward;
+            diff.forward += diff.count2 + 1;
+            diff.backward += diff.count2 + 1;
+
+            // about the square root of the amount of diagonals, but at least ALIGN_MIN_TOO_EXPENSIVE
+            diff.tooExpensive = 1;
+            for (long i = diagonals; i != 0; i >>= 2)
+                diff.tooExpensive <<= 1;
+            if (diff.tooExpensive < ALIGN_MIN_TOO_EXPENSIVE)
+                diff.tooExpensive = ALIGN_MIN_TOO_EXPENSIVE;
+
+            compareSequences(&diff, 0, diff.count1, 0, diff.count2);
+            records = writeAlignment(&diff, lines1, count1, lines2, count2, outputSink, isCaseInsensitive);
+
+            diff.forward = forward;
+            diff.backward = backward;
+        }
+    }
+
+    free(diff.forward);
+    free(diff.backward);
+    free(diff.changed1);
+    free(diff.changed2);
+    free(diff.indices1);
+    free(diff.indices2);
+    free(diff.lines1);
+    free(diff.lines2);
+    free(lines1);
+    free(lines2);
+
+    return records;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file alignDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the aligned comparison of two files.
+ *
+ * Instead of comparing the lines at the same position, the lines of both files
+ * are aligned with the O(ND) algorithm of Myers in its linear-space variant
+ * (divide and conquer with the middle snake), so an inserted or deleted line
+ * doesn't shift all following lines. The lines are compared by their hashes.
+ * Lines without an equal line in the other file are discarded beforehand, as
+ * they can never be aligned, which keeps the edit script of very different
+ * files short.
+ * Within a block of changed lines, the lines are paired in their order and
+ * their edit distance is calculated with the bit-parallel kernel. Lines without
+ * a partner are reported as deleted or inserted lines.
+ */
+
+#ifndef ALIGNDIFF_H
+#define ALIGNDIFF_H
+
+#include <stdbool.h>
+#include "lineReader.h"
+#include "outputSink.h"
+
+/**
+ * @brief Minimal cost of a middle snake, after which the search stops at the best diagonal
+ * found so far. The alignment is not minimal anymore in this case, but the runtime of very
+ * different files stays bounded.
+ */
+#define ALIGN_MIN_TOO_EXPENSIVE 4096
+
+/**
+ * @brief This function aligns the lines of both files and writes the changed, deleted and
+ * inserted lines with their edit distances to the output.
+ * @details Both files are read completely (mapped files are used directly).
+ *
+ * @param lineReader1 Pointer to the line-reader of the first input-file
+ * @param lineReader2 Pointer to the line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param isCaseInsensitive Flag if the letter case should be ignored
+ * @return The amount of written records or -1 if an error occured (errno is set)
+ */
+int64_t compareFilesAligned(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, bool isCaseInsensitive);
+
+#endif
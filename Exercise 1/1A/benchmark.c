@@ -0,0 +1,377 @@
+/**
+ * @file benchmark.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief measures the throughput of the comparison variants of mydiff
+ * @details This programm runs mydiff with every entry of variants on
+ * the two files (the output is written to /dev/null) and prints the best time of
+ * all runs, the throughput in MB/s and lines/s (both files together) and the
+ * peak resident set size of mydiff. The variant "pipe" passes the second file
+ * through a pipe to stdin, so that it is read in blocks instead of mapped.
+ * The programms takes two arguments for the files and the following options:
+ * [-n runs], the amount of runs per variant, 3 by default.
+ * [-j threads], the amount of threads of the parallel variant, one per processor by default.
+ * [-p path], the path of mydiff, ./mydiff by default.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCHMARK_BLOCK_SIZE (1 << 20) /** size of the blocks, in which the files are read */
+
+#define MAX_VARIANT_OPTIONS 4 /** maximal amount of options of a variant */
+
+static char *progName; /** name of the programm */
+
+/**
+ * @brief Data structure to store a variant of mydiff
+ * @details The options are terminated with NULL. If isParallel is true, -j with the
+ * amount of threads is added, if isPiped is true the second file is passed to stdin.
+ */
+struct variant
+{
+    const char *name;
+    const char *options[MAX_VARIANT_OPTIONS];
+    bool isParallel;
+    bool isPiped;
+};
+
+/**
+ * @brief The variants, which are measured
+ */
+static const struct variant variants[] = {
+    {"lines", {NULL}, false, false},
+    {"case-insensitive", {"-i", NULL}, false, false},
+    {"parallel", {NULL}, true, false},
+    {"index", {"-x", NULL}, false, false},
+    {"count", {"-c", NULL}, false, false},
+    {"binary", {"-F", "bin", NULL}, false, false},
+    {"aligned", {"-a", NULL}, false, false},
+    {"pipe", {NULL}, false, true}};
+
+/**
+ * @brief Data structure to store the options of the programm
+ */
+struct options
+{
+    char *fileName1;
+    char *fileName2;
+    char *programPath;
+    int runs;
+    char threads[16];
+};
+
+/**
+ * @brief Data structure to store the result of a variant
+ */
+struct result
+{
+    double seconds;
+    long peakResidentKilobytes;
+};
+
+/**
+ * @brief This functions prints the usage-Message to stderr und exits the programm with code EXIT_FAILURE.
+ * @details global variables: progName
+ */
+static void printUsageInfoAndExit(void)
+{
+    fprintf(stderr, "Usage: %s [-n runs] [-j threads] [-p path] file1 file2\n", progName);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief This functions prints the errorMessage to stderr and exits the programm with code EXIT_FAILURE.
+ * @details global variables: progName
+ *
+ * @param errorMessage The custom errorMessage which will be printed as the error to stderr
+ */
+static void printErrorAndExit(char *errorMessage)
+{
+    fprintf(stderr, "[%s] ERROR: %s: %s\n", progName, errorMessage, strerror(errno));
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief This functions prints the errorMessage to stderr and terminates the forked child with code 127.
+ * @details The child must not call exit(), because that would flush the stdio-buffers it
+ * inherited from the parent a second time. Therefore the message is written directly to
+ * the descriptor and the child is terminated with _exit().
+ * global variables: progName
+ *
+ * @param errorMessage The custom errorMessage which will be printed as the error to stderr
+ */
+static void printChildErrorAndExit(char *errorMessage)
+{
+    dprintf(STDERR_FILENO, "[%s] ERROR: %s: %s\n", progName, errorMessage, strerror(errno));
+    _exit(127);
+}
+
+/**
+ * @brief This function parses a positive number of an option. If the value is not a positive
+ * number the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @return The parsed number
+ */
+static int parsePositiveNumber(char *value)
+{
+    char *end;
+    errno = 0;
+    long number = strtol(value, &end, 10);
+
+    if (errno != 0 || end == value || *end != '\0' || number < 1 || number > INT_MAX)
+        printUsageInfoAndExit();
+
+    return number;
+}
+
+/**
+ * @brief This function parses arguments
+ * @details If the user provides wrong arguments the programm terminates with return-value
+ * EXIT_FAILURE and prints the usage-Message
+ *
+ * @param argumentCount Number of arguments provided
+ * @param arguments Values of arguments provided
+ * @param options pointer to the options, where the filenames and the specified options are saved to
+ */
+static void parseArguments(int argumentCount, char **arguments, struct options *options)
+{
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCount = (processorCount > 0 && processorCount <= INT_MAX) ? processorCount : 1;
+
+    int opt;
+    while ((opt = getopt(argumentCount, arguments, "n:j:p:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            options->runs = parsePositiveNumber(optarg);
+            break;
+        case 'j':
+            threadCount = parsePositiveNumber(optarg);
+            break;
+        case 'p':
+            options->programPath = optarg;
+            break;
+        default:
+            printUsageInfoAndExit();
+        }
+    }
+
+    if (optind + 2 != argumentCount)
+        printUsageInfoAndExit();
+
+    options->fileName1 = arguments[optind];
+    options->fileName2 = arguments[optind + 1];
+    snprintf(options->threads, sizeof(options->threads), "%d", threadCount);
+}
+
+/**
+ * @brief Counts the lines of the file. A last line without linebreak counts as line too.
+ * @details Exits with code EXIT_FAILURE if reading the file fails.
+ *
+ * @param fileName The filename/path of the file
+ * @param size Pointer which will be set to the size of the file
+ * @return The amount of lines
+ */
+static uint64_t countLines(const char *fileName, uint64_t *size)
+{
+    int fd = open(fileName, O_RDONLY);
+    char *buffer = malloc(BENCHMARK_BLOCK_SIZE);
+    if (fd == -1 || buffer == NULL)
+        printErrorAndExit("Opening an input-file failed");
+
+    uint64_t lines = 0;
+    char last = '\n';
+    ssize_t bytesRead;
+    *size = 0;
+
+    while ((bytesRead = read(fd, buffer, BENCHMARK_BLOCK_SIZE)) != 0)
+    {
+        if (bytesRead == -1 && errno == EINTR)
+            continue;
+        if (bytesRead == -1)
+            printErrorAndExit("Reading an input-file failed");
+
+        for (char *linebreak = buffer; (linebreak = memchr(linebreak, '\n', buffer + bytesRead - linebreak)) != NULL; linebreak++)
+            lines++;
+
+        *size += bytesRead;
+        last = buffer[bytesRead - 1];
+    }
+
+    free(buffer);
+    close(fd);
+
+    return lines + ((last != '\n') ? 1 : 0);
+}
+
+/**
+ * @brief Writes the file to the pipe, until the file ends or mydiff closes the pipe
+ * @details Exits with code EXIT_FAILURE if reading the file fails.
+ *
+ * @param fileName The filename/path of the file
+ * @param pipeFd File descriptor of the writing end of the pipe, which is closed afterwards
+ */
+static void feedPipe(const char *fileName, int pipeFd)
+{
+    int fd = open(fileName, O_RDONLY);
+    char *buffer = malloc(BENCHMARK_BLOCK_SIZE);
+    if (fd == -1 || buffer == NULL)
+        printErrorAndExit("Opening an input-file failed");
+
+    ssize_t bytesRead;
+    bool isClosed = false;
+    while (isClosed == false && (bytesRead = read(fd, buffer, BENCHMARK_BLOCK_SIZE)) != 0)
+    {
+        if (bytesRead == -1 && errno == EINTR)
+            continue;
+        if (bytesRead == -1)
+            printErrorAndExit("Reading an input-file failed");
+
+        ssize_t written = 0;
+        while (written < bytesRead && isClosed == false)
+        {
+            // mydiff may stop reading early, SIGPIPE is ignored and EPIPE ends the feeding
+            ssize_t bytesWritten = write(pipeFd, buffer + written, bytesRead - written);
+            if (bytesWritten == -1 && errno != EINTR)
+                isClosed = true;
+            else if (bytesWritten > 0)
+                written += bytesWritten;
+        }
+    }
+
+    free(buffer);
+    close(fd);
+    close(pipeFd);
+}
+
+/**
+ * @brief Runs mydiff once with the variant and measures the elapsed time and the peak
+ * resident set size.
+ * @details Exits with code EXIT_FAILURE if mydiff can't be started or fails.
+ *
+ * @param variant Pointer to the variant
+ * @param options Pointer to the options, which contain the files and the path of mydiff
+ * @param result Pointer to the result of this run
+ */
+static void runVariant(const struct variant *variant, const struct options *options, struct result *result)
+{
+    const char *arguments[MAX_VARIANT_OPTIONS + 8];
+    int count = 0;
+
+    arguments[count++] = options->programPath;
+    for (int i = 0; variant->options[i] != NULL; i++)
+        arguments[count++] = variant->options[i];
+    if (variant->isParallel == true)
+    {
+        arguments[count++] = "-j";
+        arguments[count++] = options->threads;
+    }
+    arguments[count++] = "-o";
+    arguments[count++] = "/dev/null";
+    arguments[count++] = options->fileName1;
+    arguments[count++] = (variant->isPiped == true) ? "-" : options->fileName2;
+    arguments[count] = NULL;
+
+    int pipeFds[2] = {-1, -1};
+    if (variant->isPiped == true && pipe(pipeFds) == -1)
+        printErrorAndExit("Creating the pipe failed");
+
+    struct timespec startTime, endTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == -1)
+        printErrorAndExit("Failed to fork");
+
+    if (pid == 0)
+    {
+        if (variant->isPiped == true && (dup2(pipeFds[0], STDIN_FILENO) == -1 || close(pipeFds[0]) == -1 || close(pipeFds[1]) == -1))
+            printChildErrorAndExit("Redirecting stdin failed");
+
+        execv(options->programPath, (char *const *)arguments);
+        printChildErrorAndExit("Failed to execute mydiff");
+    }
+
+    if (variant->isPiped == true)
+    {
+        close(pipeFds[0]);
+        feedPipe(options->fileName2, pipeFds[1]);
+    }
+
+    int status;
+    struct rusage usage;
+    while (wait4(pid, &status, 0, &usage) == -1)
+    {
+        if (errno != EINTR)
+            printErrorAndExit("Waiting for mydiff failed");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (WIFEXITED(status) == false || WEXITSTATUS(status) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "[%s] ERROR: mydiff failed in the variant %s\n", progName, variant->name);
+        exit(EXIT_FAILURE);
+    }
+
+    result->seconds = (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+    result->peakResidentKilobytes = usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[])
+{
+    struct options options = {.programPath = "./mydiff", .runs = 3};
+
+    progName = argv[0];
+    parseArguments(argc, argv, &options);
+
+    // feedPipe handles a closed pipe on its own
+    signal(SIGPIPE, SIG_IGN);
+
+    uint64_t size1, size2;
+    uint64_t lines = countLines(options.fileName1, &size1) + countLines(options.fileName2, &size2);
+    double megabytes = (size1 + size2) / 1e6;
+
+    printf("Files: %s, %s (%.1f MB, %" PRIu64 " lines), runs: %d\n", options.fileName1, options.fileName2, megabytes, lines, options.runs);
+    printf("%-18s %10s %10s %14s %14s\n", "variant", "seconds", "MB/s", "lines/s", "peak RSS (KB)");
+
+    for (size_t i = 0; i < sizeof(variants) / sizeof(variants[0]); i++)
+    {
+        struct result best = {.seconds = 0, .peakResidentKilobytes = 0};
+
+        for (int run = 0; run < options.runs; run++)
+        {
+            struct result result;
+            runVariant(&variants[i], &options, &result);
+
+            if (run == 0 || result.seconds < best.seconds)
+                best.seconds = result.seconds;
+            if (result.peakResidentKilobytes > best.peakResidentKilobytes)
+                best.peakResidentKilobytes = result.peakResidentKilobytes;
+        }
+
+        printf("%-18s %10.4f %10.1f %14.0f %14ld\n", variants[i].name, best.seconds, megabytes / best.seconds, lines / best.seconds, best.peakResidentKilobytes);
+        fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,360 @@
+/**
+ * @file corpus.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief generates a pair of files for benchmarks of mydiff
+ * @details This programm writes two files with random lines, which differ in a
+ * configurable part of the lines. The same seed always produces the same files,
+ * so that benchmarks of different builds are reproducible.
+ * The programms takes two arguments for the files and the following options:
+ * [-s size], the size of the first file in bytes (suffix K, M or G), 64M by default.
+ * [-l min:max], the range of the length of a line without the linebreak, 0:160 by default.
+ * [-m mean], with this option the length of a line is exponentially distributed with the
+ * specified mean (and cut to the range), otherwise it is uniformly distributed.
+ * [-d density], the part of the lines (0 to 1) in which 1 to CORPUS_MAX_CHANGES characters
+ * of the second file differ, 0.01 by default.
+ * [-n noise], the part of the lines (0 to 1) in which only the letter case of some characters
+ * of the second file differs, 0 by default.
+ * [-S seed], the seed of the random number generator, 1 by default.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CORPUS_MAX_CHANGES 4 /** maximal amount of changed characters in a different line */
+
+#define CORPUS_BUFFER_SIZE (1 << 20) /** size of the stdio-buffers of both files */
+
+static char *progName; /** name of the programm */
+
+/**
+ * @brief Characters, of which the random lines consist
+ */
+static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,;:-_";
+
+/**
+ * @brief Data structure to store the options of the programm
+ */
+struct options
+{
+    char *fileName1;
+    char *fileName2;
+    uint64_t size;
+    size_t minLength;
+    size_t maxLength;
+    double meanLength;
+    double density;
+    double noise;
+    uint64_t seed;
+};
+
+/**
+ * @brief This functions prints the usage-Message to stderr und exits the programm with code EXIT_FAILURE.
+ * @details global variables: progName
+ */
+static void printUsageInfoAndExit(void)
+{
+    fprintf(stderr, "Usage: %s [-s size] [-l min:max] [-m mean] [-d density] [-n noise] [-S seed] file1 file2\n", progName);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief This functions prints the errorMessage to stderr and exits the programm with code EXIT_FAILURE.
+ * @details global variables: progName
+ *
+ * @param errorMessage The custom errorMessage which will be printed as the error to stderr
+ */
+static void printErrorAndExit(char *errorMessage)
+{
+    fprintf(stderr, "[%s] ERROR: %s: %s\n", progName, errorMessage, strerror(errno));
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief This function parses a size with an optional suffix K, M or G. If the value is
+ * not a size the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @return The parsed size in bytes
+ */
+static uint64_t parseSize(char *value)
+{
+    char *end;
+    errno = 0;
+    uint64_t size = strtoull(value, &end, 10);
+    if (errno != 0 || end == value || value[0] == '-')
+        printUsageInfoAndExit();
+
+    int shift = 0;
+    if (*end == 'K')
+        shift = 10;
+    else if (*end == 'M')
+        shift = 20;
+    else if (*end == 'G')
+        shift = 30;
+
+    if ((shift > 0 && *(++end) != '\0') || *end != '\0' || size > (UINT64_MAX >> shift))
+        printUsageInfoAndExit();
+
+    return size << shift;
+}
+
+/**
+ * @brief This function parses a part between 0 and 1. If the value is not such a number
+ * the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @return The parsed part
+ */
+static double parsePart(char *value)
+{
+    char *end;
+    errno = 0;
+    double part = strtod(value, &end);
+    if (errno != 0 || end == value || *end != '\0' || part < 0 || part > 1)
+        printUsageInfoAndExit();
+
+    return part;
+}
+
+/**
+ * @brief This function parses the range of the line length (format min:max). If the range
+ * is invalid the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @param options Pointer to the options, where the range is saved to
+ */
+static void parseLengthRange(char *value, struct options *options)
+{
+    char *end;
+    errno = 0;
+    unsigned long minLength = strtoul(value, &end, 10);
+    if (errno != 0 || end == value || *end != ':' || value[0] == '-')
+        printUsageInfoAndExit();
+
+    char *max = end + 1;
+    unsigned long maxLength = strtoul(max, &end, 10);
+    if (errno != 0 || end == max || *end != '\0' || max[0] == '-' || maxLength < minLength || maxLength > INT_MAX)
+        printUsageInfoAndExit();
+
+    options->minLength = minLength;
+    options->maxLength = maxLength;
+}
+
+/**
+ * @brief This function parses arguments
+ * @details If the user provides wrong arguments the programm terminates with return-value
+ * EXIT_FAILURE and prints the usage-Message
+ *
+ * @param argumentCount Number of arguments provided
+ * @param arguments Values of arguments provided
+ * @param options pointer to the options, where the filenames and the specified options are saved to
+ */
+static void parseArguments(int argumentCount, char **arguments, struct options *options)
+{
+    char *end;
+    int opt;
+    while ((opt = getopt(argumentCount, arguments, "s:l:m:d:n:S:")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            options->size = parseSize(optarg);
+            break;
+        case 'l':
+            parseLengthRange(optarg, options);
+            break;
+        case 'm':
+            errno = 0;
+            options->meanLength = strtod(optarg, &end);
+            if (errno != 0 || end == optarg || *end != '\0' || options->meanLength <= 0)
+                printUsageInfoAndExit();
+            break;
+        case 'd':
+            options->density = parsePart(optarg);
+            break;
+        case 'n':
+            options->noise = parsePart(optarg);
+            break;
+        case 'S':
+            errno = 0;
+            options->seed = strtoull(optarg, &end, 10);
+            if (errno != 0 || end == optarg || *end != '\0' || optarg[0] == '-')
+                printUsageInfoAndExit();
+            break;
+        default:
+            printUsageInfoAndExit();
+        }
+    }
+
+    if (optind + 2 != argumentCount)
+        printUsageInfoAndExit();
+
+    options->fileName1 = arguments[optind];
+    options->fileName2 = arguments[optind + 1];
+}
+
+/**
+ * @brief Returns the next random number of the xorshift64* generator
+ *
+ * @param state Pointer to the state of the generator (never 0)
+ * @return The random number
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * UINT64_C(2685821657736338717);
+}
+
+/**
+ * @brief Returns a random number between 0 (inclusive) and 1 (exclusive)
+ *
+ * @param state Pointer to the state of the generator
+ * @return The random number
+ */
+static double nextUniform(uint64_t *state)
+{
+    return (nextRandom(state) >> 11) * (1.0 / (UINT64_C(1) << 53));
+}
+
+/**
+ * @brief Returns the length of the next line, either uniformly distributed in the range or
+ * exponentially distributed with the mean (and cut to the range)
+ *
+ * @param options Pointer to the options, which contain the range and the mean
+ * @param state Pointer to the state of the generator
+ * @return The length of the line without the linebreak
+ */
+static size_t nextLength(const struct options *options, uint64_t *state)
+{
+    if (options->meanLength > 0)
+    {
+        double length = -log(1.0 - nextUniform(state)) * options->meanLength;
+        if (length < options->minLength)
+            return options->minLength;
+        if (length > options->maxLength)
+            return options->maxLength;
+        return (size_t)length;
+    }
+
+    return options->minLength + nextRandom(state) % (options->maxLength - options->minLength + 1);
+}
+
+/**
+ * @brief Changes the letter case of a character, if it is a letter
+ *
+ * @param character The character
+ * @return The character with the other letter case or the unchanged character
+ */
+static char flipCase(char character)
+{
+    if (character >= 'a' && character <= 'z')
+        return character - 'a' + 'A';
+    if (character >= 'A' && character <= 'Z')
+        return character - 'A' + 'a';
+
+    return character;
+}
+
+/**
+ * @brief Writes the line to the file and exits with code EXIT_FAILURE, if writing fails
+ *
+ * @param line Pointer to the line
+ * @param length Length of the line without the linebreak
+ * @param file Pointer to the file
+ */
+static void writeLine(char *line, size_t length, FILE *file)
+{
+    line[length] = '\n';
+    if (fwrite(line, 1, length + 1, file) != length + 1)
+        printErrorAndExit("Writing a file failed");
+}
+
+/**
+ * @brief Generates the lines of both files, until the first file has the specified size
+ *
+ * @param options Pointer to the options
+ * @param file1 Pointer to the first file
+ * @param file2 Pointer to the second file
+ */
+static void generateCorpus(const struct options *options, FILE *file1, FILE *file2)
+{
+    char *line1 = malloc(options->maxLength + 1);
+    char *line2 = malloc(options->maxLength + 1);
+    if (line1 == NULL || line2 == NULL)
+        printErrorAndExit("Allocation of the lines failed");
+
+    uint64_t state = (options->seed == 0) ? 1 : options->seed;
+
+    for (uint64_t written = 0; written < options->size;)
+    {
+        size_t length = nextLength(options, &state);
+        for (size_t i = 0; i < length; i++)
+            line1[i] = alphabet[nextRandom(&state) % (sizeof(alphabet) - 1)];
+        memcpy(line2, line1, length);
+
+        if (length > 0 && nextUniform(&state) < options->density)
+        {
+            // replace the characters with other characters, which also differ in the letter case
+            int changes = 1 + nextRandom(&state) % CORPUS_MAX_CHANGES;
+            for (int i = 0; i < changes; i++)
+            {
+                size_t position = nextRandom(&state) % length;
+                do
+                {
+                    line2[position] = alphabet[nextRandom(&state) % (sizeof(alphabet) - 1)];
+                } while (line2[position] == line1[position] || flipCase(line2[position]) == line1[position]);
+            }
+        }
+        else if (length > 0 && nextUniform(&state) < options->noise)
+        {
+            int changes = 1 + nextRandom(&state) % CORPUS_MAX_CHANGES;
+            for (int i = 0; i < changes; i++)
+            {
+                size_t position = nextRandom(&state) % length;
+                line2[position] = flipCase(line1[position]);
+            }
+        }
+
+        writeLine(line1, length, file1);
+        writeLine(line2, length, file2);
+        written += length + 1;
+    }
+
+    free(line1);
+    free(line2);
+}
+
+int main(int argc, char *argv[])
+{
+    struct options options = {.size = UINT64_C(64) << 20, .minLength = 0, .maxLength = 160, .density = 0.01, .seed = 1};
+
+    progName = argv[0];
+    parseArguments(argc, argv, &options);
+
+    FILE *file1 = fopen(options.fileName1, "w");
+    FILE *file2 = fopen(options.fileName2, "w");
+    if (file1 == NULL || file2 == NULL)
+        printErrorAndExit("Opening or creating a file failed");
+
+    setvbuf(file1, NULL, _IOFBF, CORPUS_BUFFER_SIZE);
+    setvbuf(file2, NULL, _IOFBF, CORPUS_BUFFER_SIZE);
+
+    generateCorpus(&options, file1, file2);
+
+    if (fclose(file1) == EOF || fclose(file2) == EOF)
+        printErrorAndExit("Closing a file failed");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,379 @@
+/**
+ * @file diffKernel.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the kernels which count differing characters.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "diffKernel.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Mask with the lower seven bits of every byte set
+ */
+#define LOW_BITS 0x7F7F7F7F7F7F7F7FULL
+
+/**
+ * @brief Mask with the highest bit of every byte set
+ */
+#define HIGH_BITS 0x8080808080808080ULL
+
+/**
+ * @brief Table which maps every character to its lowercase character (C locale)
+ */
+static const unsigned char foldTable[256] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+    0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+    0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+    0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF};
+
+/**
+ * @brief Primes which are used to mix the words of a line into the hash
+ */
+#define HASH_PRIME1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME2 0xC2B2AE3D27D4EB4FULL
+
+/**
+ * @brief Counts the bytes of a 64-bit word which are not zero
+ * @details The lower seven bits of every byte are added with 0x7F, so that the
+ * highest bit is set if any of the lower bits was set. This can never carry into
+ * the next byte.
+ *
+ * @param word The word to check
+ * @return The amount of bytes which are not zero
+ */
+static size_t countNonZeroBytes(uint64_t word)
+{
+    return __builtin_popcountll((((word & LOW_BITS) + LOW_BITS) | word) & HIGH_BITS);
+}
+
+size_t countDifferences(const char *line1, const char *line2, size_t length)
+{
+    size_t differences = 0, i = 0;
+
+#ifdef __SSE2__
+    // compare 64 bytes per iteration, every equal byte sets one bit of the mask
+    for (; i + 64 <= length; i += 64)
+    {
+        uint64_t equalMask = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            __m128i block1 = _mm_loadu_si128((const __m128i *)(line1 + i + j * 16));
+            __m128i block2 = _mm_loadu_si128((const __m128i *)(line2 + i + j * 16));
+            equalMask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)) << (j * 16);
+        }
+        differences += __builtin_popcountll(~equalMask);
+    }
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block1 = _mm_loadu_si128((const __m128i *)(line1 + i));
+        __m128i block2 = _mm_loadu_si128((const __m128i *)(line2 + i));
+        differences += 16 - __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)));
+    }
+#endif
+
+    // compare 8 bytes per iteration (memcpy because the lines are not aligned)
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word1, word2;
+        memcpy(&word1, line1 + i, sizeof(word1));
+        memcpy(&word2, line2 + i, sizeof(word2));
+        differences += countNonZeroBytes(word1 ^ word2);
+    }
+
+    for (; i < length; i++)
+    {
+        if (line1[i] != line2[i])
+            differences++;
+    }
+
+    return differences;
+}
+
+/**
+ * @brief Converts all uppercase letters of a 64-bit word to lowercase letters
+ * @details A byte is an uppercase letter, if its lower seven bits are at least 'A' and
+ * at most 'Z' and its highest bit isn't set. For those bytes the bit 0x20 gets set.
+ *
+ * @param word The word to convert
+ * @return The converted word
+ */
+static uint64_t foldWord(uint64_t word)
+{
+    uint64_t lowBits = word & LOW_BITS;
+    uint64_t atLeastA = lowBits + 0x0101010101010101ULL * (0x80 - 'A');
+    uint64_t aboveZ = lowBits + 0x0101010101010101ULL * (0x80 - 'Z' - 1);
+    uint64_t isUpper = atLeastA & ~aboveZ & ~word & HIGH_BITS;
+
+    return word | (isUpper >> 2);
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Converts all uppercase letters of a SSE2 block to lowercase letters
+ * @details The bytes are shifted so that 'A' is the smallest signed byte, then
+ * all uppercase letters are smaller than the 26th smallest signed byte.
+ *
+ * @param block The block to convert
+ * @return The converted block
+ */
+static __m128i foldBlock(__m128i block)
+{
+    __m128i shifted = _mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+
+    return _mm_or_si128(block, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+size_t countDifferencesCaseInsensitive(const char *line1, const char *line2, size_t length)
+{
+    size_t differences = 0, i = 0;
+
+#ifdef __SSE2__
+    // fold 64 bytes per iteration, every equal byte sets one bit of the mask
+    for (; i + 64 <= length; i += 64)
+    {
+        uint64_t equalMask = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            __m128i block1 = foldBlock(_mm_loadu_si128((const __m128i *)(line1 + i + j * 16)));
+            __m128i block2 = foldBlock(_mm_loadu_si128((const __m128i *)(line2 + i + j * 16)));
+            equalMask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)) << (j * 16);
+        }
+        differences += __builtin_popcountll(~equalMask);
+    }
+
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block1 = foldBlock(_mm_loadu_si128((const __m128i *)(line1 + i)));
+        __m128i block2 = foldBlock(_mm_loadu_si128((const __m128i *)(line2 + i)));
+        differences += 16 - __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)));
+    }
+#endif
+
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word1, word2;
+        memcpy(&word1, line1 + i, sizeof(word1));
+        memcpy(&word2, line2 + i, sizeof(word2));
+        differences += countNonZeroBytes(foldWord(word1) ^ foldWord(word2));
+    }
+
+    for (; i < length; i++)
+    {
+        if (foldTable[(unsigned char)line1[i]] != foldTable[(unsigned char)line2[i]])
+            differences++;
+    }
+
+    return differences;
+}
+
+size_t countLinebreaks(const char *data, size_t length)
+{
+    size_t linebreaks = 0, i = 0;
+
+#ifdef __SSE2__
+    const __m128i linebreak = _mm_set1_epi8('\n');
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        linebreaks += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, linebreak)));
+    }
+#endif
+
+    for (; i < length; i++)
+    {
+        if (data[i] == '\n')
+            linebreaks++;
+    }
+
+    return linebreaks;
+}
+
+/**
+ * @brief Mixes the bits of the hash, so that every input bit affects every output bit
+ *
+ * @param hash The hash which should be mixed
+ * @return The mixed hash
+ */
+static uint64_t mixHash(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/**
+ * @brief Calculates the hash of the line, optionally of its lowercase characters
+ *
+ * @param line Pointer to the first character of the line
+ * @param length Length of the line
+ * @param isCaseInsensitive Flag if the uppercase letters should be converted before hashing
+ * @return The hash of the line
+ */
+static uint64_t hashWords(const char *line, size_t length, bool isCaseInsensitive)
+{
+    uint64_t hash = length * HASH_PRIME1;
+    size_t i = 0;
+
+    // mix 8 bytes per iteration into the hash
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, line + i, sizeof(word));
+        if (isCaseInsensitive == true)
+            word = foldWord(word);
+        word *= HASH_PRIME2;
+        word = (word << 31) | (word >> 33);
+        hash ^= word * HASH_PRIME1;
+        hash = ((hash << 27) | (hash >> 37)) * HASH_PRIME1 + HASH_PRIME2;
+    }
+
+    if (i < length)
+    {
+        uint64_t word = 0;
+        memcpy(&word, line + i, length - i);
+        if (isCaseInsensitive == true)
+            word = foldWord(word);
+        hash ^= word * HASH_PRIME2;
+        hash = ((hash << 27) | (hash >> 37)) * HASH_PRIME1;
+    }
+
+    return mixHash(hash);
+}
+
+uint64_t hashLine(const char *line, size_t length)
+{
+    return hashWords(line, length, false);
+}
+
+uint64_t hashLineCaseInsensitive(const char *line, size_t length)
+{
+    return hashWords(line, length, true);
+}
+
+/**
+ * @brief Advances one block of the bit-parallel edit distance by one character of the text
+ * @details The bits of the block are 64 rows (characters of the pattern) of one column of the
+ * dynamic programming matrix. Pv/Mv mark the rows, whose vertical delta is +1/-1, the horizontal
+ * delta of the row above the block comes in and the one of the output row goes out.
+ *
+ * @param positiveVertical Pointer to the bit-vector of the positive vertical deltas
+ * @param negativeVertical Pointer to the bit-vector of the negative vertical deltas
+ * @param equal Bit-vector of the rows, whose character is equal to the character of the text
+ * @param horizontalIn Horizontal delta (-1, 0 or +1) of the row above the block
+ * @param outputRow Bit of the row, whose horizontal delta is returned
+ * @return The horizontal delta of the output row
+ */
+static int advanceBlock(uint64_t *positiveVertical, uint64_t *negativeVertical, uint64_t equal, int horizontalIn, uint64_t outputRow)
+{
+    uint64_t isNegativeIn = (horizontalIn < 0) ? 1 : 0;
+    uint64_t isPositiveIn = (horizontalIn > 0) ? 1 : 0;
+
+    uint64_t verticalMatch = equal | *negativeVertical;
+    equal |= isNegativeIn;
+    uint64_t horizontalMatch = (((equal & *positiveVertical) + *positiveVertical) ^ *positiveVertical) | equal;
+    uint64_t positiveHorizontal = *negativeVertical | ~(horizontalMatch | *positiveVertical);
+    uint64_t negativeHorizontal = *positiveVertical & horizontalMatch;
+
+    int horizontalOut = ((positiveHorizontal & outputRow) != 0) - ((negativeHorizontal & outputRow) != 0);
+
+    positiveHorizontal = (positiveHorizontal << 1) | isPositiveIn;
+    negativeHorizontal = (negativeHorizontal << 1) | isNegativeIn;
+    *positiveVertical = negativeHorizontal | ~(verticalMatch | positiveHorizontal);
+    *negativeVertical = positiveHorizontal & verticalMatch;
+
+    return horizontalOut;
+}
+
+size_t editDistance(const char *line1, size_t length1, const char *line2, size_t length2, bool isCaseInsensitive)
+{
+    // the shorter line is the pattern, whose characters are the rows of the bit-vectors
+    if (length1 > length2)
+    {
+        const char *line = line1;
+        line1 = line2;
+        line2 = line;
+        size_t length = length1;
+        length1 = length2;
+        length2 = length;
+    }
+
+    if (length1 == 0)
+        return length2;
+
+    const unsigned char *pattern = (const unsigned char *)line1, *text = (const unsigned char *)line2;
+    size_t blockCount = (length1 + 63) / 64;
+
+    uint64_t stackVectors[256 + 2];
+    uint64_t *vectors = stackVectors;
+    if (blockCount > 1 && (vectors = malloc((256 + 2) * blockCount * sizeof(uint64_t))) == NULL)
+        return SIZE_MAX;
+
+    // equalVectors[c * blockCount + b] has the bits of the rows of block b, whose character is c
+    uint64_t *equalVectors = vectors, *positiveVertical = vectors + 256 * blockCount, *negativeVertical = positiveVertical + blockCount;
+    memset(equalVectors, 0, 256 * blockCount * sizeof(uint64_t));
+    for (size_t i = 0; i < length1; i++)
+    {
+        unsigned char c = (isCaseInsensitive == true) ? foldTable[pattern[i]] : pattern[i];
+        equalVectors[c * blockCount + i / 64] |= 1ULL << (i % 64);
+    }
+
+    for (size_t b = 0; b < blockCount; b++)
+    {
+        positiveVertical[b] = ~0ULL;
+        negativeVertical[b] = 0;
+    }
+
+    uint64_t lastRow = 1ULL << ((length1 - 1) % 64);
+    size_t distance = length1;
+
+    for (size_t j = 0; j < length2; j++)
+    {
+        unsigned char c = (isCaseInsensitive == true) ? foldTable[text[j]] : text[j];
+        const uint64_t *equal = equalVectors + c * blockCount;
+
+        // the first row of the matrix grows by one per column
+        int horizontal = 1;
+        for (size_t b = 0; b + 1 < blockCount; b++)
+            horizontal = advanceBlock(&positiveVertical[b], &negativeVertical[b], equal[b], horizontal, 1ULL << 63);
+        horizontal = advanceBlock(&positiveVertical[blockCount - 1], &negativeVertical[blockCount - 1], equal[blockCount - 1], horizontal, lastRow);
+
+        distance += horizontal;
+    }
+
+    if (vectors != stackVectors)
+        free(vectors);
+
+    return distance;
+}
+
+diffKernel selectDiffKernel(bool isCaseInsensitive)
+{
+    return (isCaseInsensitive == true) ? &countDifferencesCaseInsensitive : &countDifferences;
+}
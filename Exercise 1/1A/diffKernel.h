@@ -0,0 +1,111 @@
+/**
+ * @file diffKernel.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the kernels which count differing characters.
+ *
+ * This module defines the functions which compare two lines of the same
+ * length and return the amount of positions where the characters differ,
+ * the function which counts the lines of a memory area and the function
+ * which hashes a line.
+ * The kernels work on whole blocks of bytes at once (SSE2 if available,
+ * otherwise 64-bit words) and count the differences with a popcount.
+ */
+
+#ifndef DIFFKERNEL_H
+#define DIFFKERNEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Datatype of a kernel which counts the differing characters of two lines
+ */
+typedef size_t (*diffKernel)(const char *line1, const char *line2, size_t length);
+
+/**
+ * @brief This function counts the positions where the two lines differ. The
+ * comparison is case sensitive.
+ * @details Both pointers have to be valid for at least length bytes.
+ *
+ * @param line1 Pointer to the first line
+ * @param line2 Pointer to the second line
+ * @param length Number of characters which should be compared
+ * @return The amount of differing characters
+ */
+size_t countDifferences(const char *line1, const char *line2, size_t length);
+
+/**
+ * @brief This function counts the positions where the two lines differ, but
+ * ignores the letter case (like strncasecmp in the C locale).
+ * @details Both pointers have to be valid for at least length bytes. The letters
+ * are folded to lowercase block-wise, the remaining characters with a table.
+ *
+ * @param line1 Pointer to the first line
+ * @param line2 Pointer to the second line
+ * @param length Number of characters which should be compared
+ * @return The amount of differing characters
+ */
+size_t countDifferencesCaseInsensitive(const char *line1, const char *line2, size_t length);
+
+/**
+ * @brief This function counts the linebreaks in the specified memory area.
+ * @details The pointer has to be valid for at least length bytes.
+ *
+ * @param data Pointer to the first character
+ * @param length Number of characters which should be searched
+ * @return The amount of linebreaks
+ */
+size_t countLinebreaks(const char *data, size_t length);
+
+/**
+ * @brief This function calculates a 64-bit hash of the specified line. Lines with
+ * different hashes are never identical, lines with the same hash and length are
+ * identical with a very high probability.
+ * @details The pointer has to be valid for at least length bytes. The hash is the
+ * same on every run, so that it can be stored in a file.
+ *
+ * @param line Pointer to the first character of the line
+ * @param length Length of the line
+ * @return The hash of the line
+ */
+uint64_t hashLine(const char *line, size_t length);
+
+/**
+ * @brief This function calculates the same hash as hashLine for the line, whose uppercase
+ * letters are converted to lowercase letters. Lines which only differ in the letter case
+ * have the same hash.
+ *
+ * @param line Pointer to the first character of the line
+ * @param length Length of the line
+ * @return The hash of the lowercase line
+ */
+uint64_t hashLineCaseInsensitive(const char *line, size_t length);
+
+/**
+ * @brief This function calculates the edit distance (Levenshtein distance: insertions, deletions
+ * and substitutions of single characters) of two lines with the bit-parallel algorithm of Myers
+ * and Hyyrö. 64 characters of the shorter line are processed per operation.
+ * @details Lines with more than 64 characters need an allocation, if it fails SIZE_MAX is returned.
+ *
+ * @param line1 Pointer to the first character of the first line
+ * @param length1 Length of the first line
+ * @param line2 Pointer to the first character of the second line
+ * @param length2 Length of the second line
+ * @param isCaseInsensitive Flag if the letter case should be ignored
+ * @return The edit distance of both lines
+ */
+size_t editDistance(const char *line1, size_t length1, const char *line2, size_t length2, bool isCaseInsensitive);
+
+/**
+ * @brief Returns the kernel which should be used for the comparison. This
+ * function should be called once at startup and not per line.
+ *
+ * @param isCaseInsensitive Flag if the comparison should be case insensitive
+ * @return The kernel for the requested comparison
+ */
+diffKernel selectDiffKernel(bool isCaseInsensitive);
+
+#endif
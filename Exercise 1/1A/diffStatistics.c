@@ -0,0 +1,58 @@
+/**
+ * @file diffStatistics.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the statistics of a comparison.
+ */
+
+#include <inttypes.h>
+#include "diffStatistics.h"
+
+void recordDifference(struct diffStatistics *statistics, uint64_t characters)
+{
+    // the bucket is the amount of significant bits of the characters
+    int bucket = (characters == 0) ? 0 : 64 - __builtin_clzll(characters);
+
+    statistics->differentLines++;
+    statistics->differentCharacters += characters;
+    statistics->histogram[bucket]++;
+}
+
+void mergeStatistics(struct diffStatistics *statistics, const struct diffStatistics *source)
+{
+    statistics->differentLines += source->differentLines;
+    statistics->differentCharacters += source->differentCharacters;
+
+    for (int i = 0; i < STATISTICS_BUCKET_COUNT; i++)
+        statistics->histogram[i] += source->histogram[i];
+}
+
+int printStatistics(FILE *file, const struct diffStatistics *statistics, uint64_t lines, uint64_t bytes, double seconds)
+{
+    // a comparison faster than the clock is printed without throughput
+    double bytesPerSecond = (seconds > 0) ? bytes / seconds : 0;
+    double linesPerSecond = (seconds > 0) ? lines / seconds : 0;
+
+    if (fprintf(file, "Read lines: %" PRIu64 ", bytes: %" PRIu64 "\n", lines, bytes) < 0 ||
+        fprintf(file, "Different lines: %" PRIu64 ", characters: %" PRIu64 "\n", statistics->differentLines, statistics->differentCharacters) < 0 ||
+        fprintf(file, "Time: %.6f s, bytes/s: %.0f, lines/s: %.0f\n", seconds, bytesPerSecond, linesPerSecond) < 0 ||
+        fprintf(file, "Characters per different line:\n") < 0)
+        return -1;
+
+    for (int i = 0; i < STATISTICS_BUCKET_COUNT; i++)
+    {
+        if (statistics->histogram[i] == 0)
+            continue;
+
+        uint64_t low = (i == 0) ? 0 : UINT64_C(1) << (i - 1);
+        uint64_t high = (i == 0) ? 0 : low * 2 - 1;
+
+        int status = (low == high) ? fprintf(file, "%" PRIu64 ": %" PRIu64 "\n", low, statistics->histogram[i])
+                                   : fprintf(file, "%" PRIu64 "-%" PRIu64 ": %" PRIu64 "\n", low, high, statistics->histogram[i]);
+        if (status < 0)
+            return -1;
+    }
+
+    return 0;
+}
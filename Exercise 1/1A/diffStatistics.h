@@ -0,0 +1,66 @@
+/**
+ * @file diffStatistics.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the statistics of a comparison.
+ *
+ * The statistics count the different lines and characters and sort every
+ * different line into a histogram by its amount of different characters.
+ * The buckets grow by powers of two: bucket 0 counts the lines with 0
+ * characters (e.g. an empty deleted line), bucket k the lines with 2^(k-1)
+ * to 2^k - 1 characters. Together with the amount of read lines and bytes
+ * and the elapsed time they are printed with the throughput of the comparison.
+ */
+
+#ifndef DIFFSTATISTICS_H
+#define DIFFSTATISTICS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Amount of buckets of the histogram (0 and one per bit of a 64-bit counter)
+ */
+#define STATISTICS_BUCKET_COUNT 65
+
+/**
+ * @brief Datatype of the statistics of a comparison
+ */
+struct diffStatistics
+{
+    uint64_t differentLines;
+    uint64_t differentCharacters;
+    uint64_t histogram[STATISTICS_BUCKET_COUNT];
+};
+
+/**
+ * @brief This function adds one different line to the statistics.
+ *
+ * @param statistics Pointer to the statistics
+ * @param characters Amount of different characters of the line
+ */
+void recordDifference(struct diffStatistics *statistics, uint64_t characters);
+
+/**
+ * @brief This function adds the statistics of the source to the statistics.
+ *
+ * @param statistics Pointer to the statistics
+ * @param source Pointer to the statistics, which should be added
+ */
+void mergeStatistics(struct diffStatistics *statistics, const struct diffStatistics *source);
+
+/**
+ * @brief This function prints the totals, the throughput and the non-empty buckets of
+ * the histogram as text.
+ *
+ * @param file Pointer to the stream, to which the statistics are printed
+ * @param statistics Pointer to the statistics
+ * @param lines Amount of lines, which were read from all input-files
+ * @param bytes Amount of bytes, which were read from all input-files
+ * @param seconds Elapsed time of the comparison in seconds
+ * @return 0 on success and -1 on error
+ */
+int printStatistics(FILE *file, const struct diffStatistics *statistics, uint64_t lines, uint64_t bytes, double seconds);
+
+#endif
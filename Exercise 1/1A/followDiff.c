@@ -0,0 +1,379 @@
+/**
+ * @file followDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the incremental comparison of two growing files.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "diffKernel.h"
+#include "followDiff.h"
+#include "lineReader.h"
+
+/**
+ * @brief Suffix which is appended to the name of the state-file while it is written
+ */
+#define TEMPORARY_SUFFIX ".tmp"
+
+/**
+ * @brief Resets the follow-state to the start of both files
+ * @details The device and the inode of the files are kept.
+ *
+ * @param state Pointer to the follow-state
+ */
+static void resetFollowState(struct followState *state)
+{
+    state->offset1 = 0;
+    state->offset2 = 0;
+    state->line = 1;
+    state->prefixHash1 = hashLine("", 0);
+    state->prefixHash2 = hashLine("", 0);
+}
+
+/**
+ * @brief Calculates the hash of the first bytes of the file up to the offset (at most FOLLOW_PREFIX_SIZE bytes)
+ * @details If the file is shorter, the hash of the shorter start is returned, which doesn't match.
+ *
+ * @param fd File descriptor of the file
+ * @param offset Offset of the first line, which isn't compared yet
+ * @param hash Pointer which will be set to the hash
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int hashPrefix(int fd, uint64_t offset, uint64_t *hash)
+{
+    char prefix[FOLLOW_PREFIX_SIZE];
+    size_t length = (offset < FOLLOW_PREFIX_SIZE) ? offset : FOLLOW_PREFIX_SIZE;
+    size_t loaded = 0;
+
+    while (loaded < length)
+    {
+        ssize_t bytesRead = pread(fd, prefix + loaded, length - loaded, loaded);
+        if (bytesRead == -1 && errno == EINTR)
+            continue;
+        if (bytesRead == -1)
+            return -1;
+        if (bytesRead == 0)
+            break;
+
+        loaded += bytesRead;
+    }
+
+    *hash = hashLine(prefix, loaded);
+
+    return 0;
+}
+
+/**
+ * @brief Returns true, if the loaded follow-state belongs to both files: the device, the inode
+ * and the prefix-hashes are the same
+ *
+ * @param state Pointer to the loaded follow-state
+ * @param fd1 File descriptor of the first input-file
+ * @param status1 Pointer to the status of the first input-file
+ * @param fd2 File descriptor of the second input-file
+ * @param status2 Pointer to the status of the second input-file
+ * @return true if the follow-state can be used, otherwise false (also if a file can't be read)
+ */
+static bool isSameFiles(const struct followState *state, int fd1, const struct stat *status1, int fd2, const struct stat *status2)
+{
+    if (state->device1 != (uint64_t)status1->st_dev || state->inode1 != (uint64_t)status1->st_ino ||
+        state->device2 != (uint64_t)status2->st_dev || state->inode2 != (uint64_t)status2->st_ino)
+        return false;
+
+    uint64_t prefixHash1, prefixHash2;
+    if (hashPrefix(fd1, state->offset1, &prefixHash1) == -1 || hashPrefix(fd2, state->offset2, &prefixHash2) == -1)
+        return false;
+
+    return prefixHash1 == state->prefixHash1 && prefixHash2 == state->prefixHash2;
+}
+
+int loadFollowState(const char *fileName, struct followState *state)
+{
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL)
+        return -1;
+
+    struct followState loaded;
+    int matched = fscanf(file, "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNx64 " %" SCNu64 " %" SCNu64 " %" SCNx64,
+                         &loaded.offset1, &loaded.offset2, &loaded.line, &loaded.device1, &loaded.inode1, &loaded.prefixHash1,
+                         &loaded.device2, &loaded.inode2, &loaded.prefixHash2);
+    fclose(file);
+
+    // a state-file without the identity of the files (or of an older version) isn't used
+    if (matched != 9 || loaded.line < 1)
+        return -1;
+
+    *state = loaded;
+
+    return 0;
+}
+
+int saveFollowState(const char *fileName, const struct followState *state)
+{
+    size_t length = strlen(fileName);
+    char *temporaryName = malloc(length + sizeof(TEMPORARY_SUFFIX));
+    if (temporaryName == NULL)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    memcpy(temporaryName, fileName, length);
+    memcpy(temporaryName + length, TEMPORARY_SUFFIX, sizeof(TEMPORARY_SUFFIX));
+
+    int returnValue = -1;
+    FILE *file = fopen(temporaryName, "w");
+    if (file != NULL)
+    {
+        if (fprintf(file, "%" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %016" PRIx64 " %" PRIu64 " %" PRIu64 " %016" PRIx64 "\n",
+                    state->offset1, state->offset2, state->line, state->device1, state->inode1, state->prefixHash1,
+                    state->device2, state->inode2, state->prefixHash2) > 0)
+            returnValue = 0;
+
+        if (fclose(file) == EOF)
+            returnValue = -1;
+
+        if (returnValue == 0)
+            returnValue = rename(temporaryName, fileName);
+
+        if (returnValue == -1)
+        {
+            // keep errno of the failed call and don't leave the temporary file behind
+            int error = errno;
+            unlink(temporaryName);
+            errno = error;
+        }
+    }
+
+    free(temporaryName);
+
+    return returnValue;
+}
+
+/**
+ * @brief Reads the complete lines after the offset. At most FOLLOW_BLOCK_SIZE bytes are read,
+ * unless the first line is longer.
+ *
+ * @param fd File descriptor of the file
+ * @param offset Offset of the first line, which should be read
+ * @param size Size of the file
+ * @param data Pointer which will be set to the allocated buffer (or NULL, if no line was read)
+ * @param length Pointer which will be set to the length of the complete lines in the buffer
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int readCompleteLines(int fd, uint64_t offset, uint64_t size, char **data, size_t *length)
+{
+    *data = NULL;
+    *length = 0;
+
+    uint64_t available = size - offset;
+    size_t capacity = (available < FOLLOW_BLOCK_SIZE) ? available : FOLLOW_BLOCK_SIZE;
+    size_t loaded = 0;
+    char *buffer = NULL;
+
+    while (capacity > loaded)
+    {
+        char *grown = realloc(buffer, capacity);
+        if (grown == NULL)
+        {
+            free(buffer);
+            errno = ENOMEM;
+            return -1;
+        }
+        buffer = grown;
+
+        while (loaded < capacity)
+        {
+            ssize_t bytesRead = pread(fd, buffer + loaded, capacity - loaded, offset + loaded);
+            if (bytesRead == -1 && errno == EINTR)
+                continue;
+            if (bytesRead == -1)
+            {
+                free(buffer);
+                return -1;
+            }
+            if (bytesRead == 0)
+                break;
+
+            loaded += bytesRead;
+        }
+
+        // the lines end after the last linebreak, a line without linebreak is still being written
+        size_t lineEnd = loaded;
+        while (lineEnd > 0 && buffer[lineEnd - 1] != '\n')
+            lineEnd--;
+
+        if (lineEnd > 0)
+        {
+            *data = buffer;
+            *length = lineEnd;
+            return 0;
+        }
+
+        // the first line is longer than the buffer, so the buffer is doubled
+        if (loaded < capacity || capacity == available)
+            break;
+        capacity = (available - capacity < capacity) ? available : capacity * 2;
+    }
+
+    free(buffer);
+
+    return 0;
+}
+
+int64_t compareAppendedLines(int fd1, int fd2, struct followState *state, struct outputSink *outputSink, diffKernel kernel)
+{
+    struct stat status1, status2;
+    if (fstat(fd1, &status1) == -1 || fstat(fd2, &status2) == -1)
+        return -1;
+
+    if ((uint64_t)status1.st_size < state->offset1 || (uint64_t)status2.st_size < state->offset2)
+        resetFollowState(state);
+
+    char *data1, *data2 = NULL;
+    size_t length1, length2 = 0;
+    if (readCompleteLines(fd1, state->offset1, status1.st_size, &data1, &length1) == -1)
+        return -1;
+    if (length1 > 0 && readCompleteLines(fd2, state->offset2, status2.st_size, &data2, &length2) == -1)
+    {
+        free(data1);
+        return -1;
+    }
+
+    struct lineReader lineReader1, lineReader2;
+    initMemoryLineReader(&lineReader1, data1, length1);
+    initMemoryLineReader(&lineReader2, data2, length2);
+
+    const char *line1, *line2;
+    size_t lineLength1, lineLength2, consumed1 = 0, consumed2 = 0;
+    int64_t lines = 0;
+
+    // every read line ends with a linebreak, so only lines with a partner are consumed
+    while (length2 > 0 && readLine(&lineReader1, &line1, &lineLength1) == 1 && readLine(&lineReader2, &line2, &lineLength2) == 1)
+    {
+        size_t differencePerLine = kernel(line1, line2, (lineLength1 < lineLength2) ? lineLength1 : lineLength2);
+        if (differencePerLine > 0 && writeDifference(outputSink, state->line + lines, differencePerLine) == -1)
+        {
+            lines = -1;
+            break;
+        }
+
+        consumed1 = line1 + lineLength1 + 1 - data1;
+        consumed2 = line2 + lineLength2 + 1 - data2;
+        lines++;
+    }
+
+    // the prefix-hashes only cover the first FOLLOW_PREFIX_SIZE bytes, so they don't change for larger offsets
+    bool isPrefixGrowing = state->offset1 < FOLLOW_PREFIX_SIZE || state->offset2 < FOLLOW_PREFIX_SIZE;
+    if (lines > 0)
+    {
+        state->offset1 += consumed1;
+        state->offset2 += consumed2;
+        state->line += lines;
+
+        if (isPrefixGrowing == true &&
+            (hashPrefix(fd1, state->offset1, &state->prefixHash1) == -1 || hashPrefix(fd2, state->offset2, &state->prefixHash2) == -1))
+            lines = -1;
+    }
+
+    free(data1);
+    free(data2);
+
+    return lines;
+}
+
+/**
+ * @brief Waits until one of the files is modified or FOLLOW_INTERVAL milliseconds passed
+ *
+ * @param notifyFd File descriptor of the inotify-instance or -1, if the files are polled
+ */
+static void waitForAppend(int notifyFd)
+{
+    struct pollfd pollFd = {.fd = notifyFd, .events = POLLIN};
+
+    // a signal interrupts the waiting, so that the stop-flag is checked
+    if (poll(&pollFd, (notifyFd != -1) ? 1 : 0, FOLLOW_INTERVAL) > 0)
+    {
+        char events[sizeof(struct inotify_event) + NAME_MAX + 1];
+        while (read(notifyFd, events, sizeof(events)) > 0)
+            continue;
+    }
+}
+
+/**
+ * @brief Creates an inotify-instance, which watches both files for modifications
+ *
+ * @param fileName1 The filename/path of the first input-file
+ * @param fileName2 The filename/path of the second input-file
+ * @return File descriptor of the inotify-instance or -1, if the files have to be polled
+ */
+static int watchFiles(const char *fileName1, const char *fileName2)
+{
+    int notifyFd = inotify_init1(IN_NONBLOCK);
+    if (notifyFd == -1)
+        return -1;
+
+    if (inotify_add_watch(notifyFd, fileName1, IN_MODIFY) == -1 || inotify_add_watch(notifyFd, fileName2, IN_MODIFY) == -1)
+    {
+        close(notifyFd);
+        return -1;
+    }
+
+    return notifyFd;
+}
+
+int followFiles(const char *fileName1, int fd1, const char *fileName2, int fd2, const char *stateFileName, struct outputSink *outputSink, diffKernel kernel, volatile sig_atomic_t *isStopped)
+{
+    struct stat status1, status2;
+    if (fstat(fd1, &status1) == -1 || fstat(fd2, &status2) == -1)
+        return -1;
+
+    // a replaced or rewritten file is compared from the start again
+    struct followState state;
+    if (stateFileName == NULL || loadFollowState(stateFileName, &state) == -1 ||
+        isSameFiles(&state, fd1, &status1, fd2, &status2) == false)
+        resetFollowState(&state);
+
+    state.device1 = status1.st_dev;
+    state.inode1 = status1.st_ino;
+    state.device2 = status2.st_dev;
+    state.inode2 = status2.st_ino;
+
+    int notifyFd = watchFiles(fileName1, fileName2);
+    int returnValue = 0;
+
+    while (*isStopped == 0)
+    {
+        int64_t lines = compareAppendedLines(fd1, fd2, &state, outputSink, kernel);
+        if (lines == -1 || flushOutputSink(outputSink) == -1 ||
+            (lines > 0 && stateFileName != NULL && saveFollowState(stateFileName, &state) == -1))
+        {
+            returnValue = -1;
+            break;
+        }
+
+        // more lines may follow after a full block, otherwise wait for the next append
+        if (lines == 0)
+            waitForAppend(notifyFd);
+    }
+
+    if (notifyFd != -1)
+    {
+        int error = errno;
+        close(notifyFd);
+        errno = error;
+    }
+
+    return returnValue;
+}
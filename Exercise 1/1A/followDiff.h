@@ -0,0 +1,117 @@
+/**
+ * @file followDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the incremental comparison of two growing files.
+ *
+ * The offsets of the first line, which isn't compared yet, and its line number
+ * are kept in a follow-state. After every append (detected with inotify, or by
+ * polling every FOLLOW_INTERVAL milliseconds) only the new complete lines are
+ * read and compared, so the cost of a check depends on the amount of new data
+ * and not on the size of the files. The follow-state can be saved in a small
+ * state-file, so that the next run continues where the last one stopped. The
+ * state-file also stores the device, the inode and a hash of the start of both
+ * files, so that a replaced or rewritten file is compared from the start again.
+ */
+
+#ifndef FOLLOWDIFF_H
+#define FOLLOWDIFF_H
+
+#include <signal.h>
+#include <stdint.h>
+#include "diffKernel.h"
+#include "outputSink.h"
+
+/**
+ * @brief Interval in milliseconds, after which the files are checked without notification
+ */
+#define FOLLOW_INTERVAL 1000
+
+/**
+ * @brief Maximal amount of bytes, which is read from a file per check (unless a line is longer)
+ */
+#define FOLLOW_BLOCK_SIZE (1 << 20)
+
+/**
+ * @brief Maximal amount of bytes at the start of a file, which are hashed for the follow-state
+ */
+#define FOLLOW_PREFIX_SIZE 4096
+
+/**
+ * @brief Datatype of the follow-state
+ * @details The offsets point to the first line of each file, which isn't compared yet.
+ * The line number is the number of this line (starting with 1). The device and the inode
+ * identify the followed files, the prefix-hash is the hashLine of the first bytes of a file
+ * up to its offset (at most FOLLOW_PREFIX_SIZE bytes).
+ */
+struct followState
+{
+    uint64_t offset1;
+    uint64_t offset2;
+    uint64_t line;
+    uint64_t device1;
+    uint64_t inode1;
+    uint64_t prefixHash1;
+    uint64_t device2;
+    uint64_t inode2;
+    uint64_t prefixHash2;
+};
+
+/**
+ * @brief This function loads the follow-state from the state-file.
+ * @details The loaded follow-state isn't checked against the files (see followFiles).
+ *
+ * @param fileName The filename/path of the state-file
+ * @param state Pointer to the follow-state, which is set by this function
+ * @return 0 if the follow-state was loaded, -1 if the state-file doesn't exist or is damaged
+ */
+int loadFollowState(const char *fileName, struct followState *state);
+
+/**
+ * @brief This function saves the follow-state to the state-file. The state-file is written
+ * under a temporary name first and renamed afterwards.
+ *
+ * @param fileName The filename/path of the state-file
+ * @param state Pointer to the follow-state which should be saved
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int saveFollowState(const char *fileName, const struct followState *state);
+
+/**
+ * @brief This function compares the complete lines, which were appended to both files after the
+ * offsets of the follow-state, and advances the follow-state behind the compared lines.
+ * @details Lines of one file without a partner in the other file stay uncompared until the
+ * other file grows. If a file is shorter than its offset (e.g. it was truncated), the
+ * follow-state is reset and both files are compared from the start again. The prefix-hashes
+ * are updated, as long as the offsets are smaller than FOLLOW_PREFIX_SIZE.
+ *
+ * @param fd1 File descriptor of the first input-file
+ * @param fd2 File descriptor of the second input-file
+ * @param state Pointer to the follow-state
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param kernel The kernel which counts the differing characters per line
+ * @return The amount of compared lines or -1 if an error occured (errno is set)
+ */
+int64_t compareAppendedLines(int fd1, int fd2, struct followState *state, struct outputSink *outputSink, diffKernel kernel);
+
+/**
+ * @brief This function compares the appended lines of both files over and over, until the stop-flag
+ * is set. After every check with new lines the output is flushed and the follow-state is saved.
+ * @details A loaded follow-state is only used, if the device and the inode of both files are the
+ * same and the start of both files still has the prefix-hashes, otherwise the files are compared
+ * from the start.
+ *
+ * @param fileName1 The filename/path of the first input-file (for inotify)
+ * @param fd1 File descriptor of the first input-file
+ * @param fileName2 The filename/path of the second input-file (for inotify)
+ * @param fd2 File descriptor of the second input-file
+ * @param stateFileName The filename/path of the state-file or NULL, if the follow-state is only kept in memory
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param kernel The kernel which counts the differing characters per line
+ * @param isStopped Pointer to the stop-flag, which is set by a signal-handler
+ * @return 0 if the stop-flag was set and -1 if an error occured (errno is set)
+ */
+int followFiles(const char *fileName1, int fd1, const char *fileName2, int fd2, const char *stateFileName, struct outputSink *outputSink, diffKernel kernel, volatile sig_atomic_t *isStopped);
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file lineDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the line by line comparison of two line-readers.
+ */
+
+#include "lineDiff.h"
+
+int compareLineReaders(struct lineReader *lineReader1, struct lineReader *lineReader2, diffKernel kernel, uint64_t lineIdx, uint64_t firstLine, uint64_t lastLine, struct lineReport *report)
+{
+    const char *line1, *line2;
+    size_t length1, length2;
+    int status;
+
+    for (; lineIdx <= lastLine; lineIdx++)
+    {
+        if ((status = readLine(lineReader1, &line1, &length1)) != 1)
+            return status;
+
+        if ((status = readLine(lineReader2, &line2, &length2)) != 1)
+            return (status == 0) ? 1 : -1;
+
+        if (lineIdx < firstLine)
+            continue;
+
+        // compare only up to the end of the shorter line
+        size_t differencePerLine = kernel(line1, line2, (length1 < length2) ? length1 : length2);
+        if (differencePerLine > 0)
+        {
+            if (report->output == NULL && (report->output = openOutputSink(NULL, report->format)) == NULL)
+                return -1;
+
+            if (writeDifference(report->output, lineIdx, differencePerLine) == -1)
+                return -1;
+
+            report->differentLines++;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file lineDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the line by line comparison of two line-readers.
+ *
+ * The lines of both line-readers are compared at the same position up to the
+ * end of the shorter line and the differing lines are written to a report.
+ * This loop is shared by the comparison of two files, the chunks of the
+ * multi-threaded comparison, the blocks of the reference-file and the pairs
+ * of the directory-trees.
+ */
+
+#ifndef LINEDIFF_H
+#define LINEDIFF_H
+
+#include <stdint.h>
+#include "diffKernel.h"
+#include "lineReader.h"
+#include "outputSink.h"
+
+/**
+ * @brief Datatype of the report of a line by line comparison
+ * @details If the output is NULL, it is opened in memory with the format at the first
+ * differing line, so only compared files with differences get an own output-sink.
+ * differentLines counts the differing lines of all comparisons with this report.
+ */
+struct lineReport
+{
+    struct outputSink *output;
+    enum outputFormat format;
+    uint64_t differentLines;
+};
+
+/**
+ * @brief This function compares the lines of both line-readers one after another, until one
+ * of them ends or the last line is compared, and writes the differing lines to the report.
+ * Lines before the first line are read, but not compared.
+ *
+ * @param lineReader1 Pointer to the first line-reader
+ * @param lineReader2 Pointer to the second line-reader
+ * @param kernel The kernel which counts the differing characters per line
+ * @param lineIdx Number of the next line of both line-readers (starting at 1)
+ * @param firstLine Number of the first compared line
+ * @param lastLine Number of the last compared line (UINT64_MAX for all lines)
+ * @param report Pointer to the report, which gets the differing lines
+ * @return 0 if the first line-reader ended or the last line was compared, 1 if the second
+ * line-reader ended first and -1 on error (errno is set)
+ */
+int compareLineReaders(struct lineReader *lineReader1, struct lineReader *lineReader2, diffKernel kernel, uint64_t lineIdx, uint64_t firstLine, uint64_t lastLine, struct lineReport *report);
+
+#endif
@@ -0,0 +1,426 @@
+/**
+ * @file lineIndex.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to build/load/save/close the line-index.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "diffKernel.h"
+#include "lineIndex.h"
+#include "lineReader.h"
+
+/**
+ * @brief Returns the filename of the sidecar-file (with the specified additional suffix)
+ *
+ * @param fileName The filename/path of the indexed file
+ * @param suffix Additional suffix, which is appended after INDEX_SUFFIX
+ * @return The allocated filename, or NULL if the allocation failed
+ */
+static char *getSidecarName(const char *fileName, const char *suffix)
+{
+    size_t length = strlen(fileName) + strlen(INDEX_SUFFIX) + strlen(suffix) + 1;
+    char *sidecarName = malloc(length);
+    if (sidecarName != NULL)
+        snprintf(sidecarName, length, "%s%s%s", fileName, INDEX_SUFFIX, suffix);
+
+    return sidecarName;
+}
+
+/**
+ * @brief Checks if the header belongs to the current version of the indexed file
+ *
+ * @param header Pointer to the header of the line-index
+ * @param fileStat Pointer to the status of the indexed file
+ * @return true if the line-index can be used for the file, otherwise false
+ */
+static bool isHeaderValid(const struct lineIndexHeader *header, const struct stat *fileStat)
+{
+    return memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == INDEX_VERSION &&
+           header->fileSize == (uint64_t)fileStat->st_size &&
+           header->device == (uint64_t)fileStat->st_dev &&
+           header->inode == (uint64_t)fileStat->st_ino &&
+           header->modificationSeconds == (int64_t)fileStat->st_mtim.tv_sec &&
+           header->modificationNanoseconds == (int64_t)fileStat->st_mtim.tv_nsec;
+}
+
+struct lineIndex *loadLineIndex(const char *fileName, int fd)
+{
+    struct stat fileStat, sidecarStat;
+    if (fstat(fd, &fileStat) == -1)
+        return NULL;
+
+    char *sidecarName = getSidecarName(fileName, "");
+    if (sidecarName == NULL)
+        return NULL;
+
+    int sidecarFd = open(sidecarName, O_RDONLY);
+    free(sidecarName);
+    if (sidecarFd == -1)
+        return NULL;
+
+    if (fstat(sidecarFd, &sidecarStat) == -1 || (size_t)sidecarStat.st_size < sizeof(struct lineIndexHeader))
+    {
+        close(sidecarFd);
+        return NULL;
+    }
+
+    size_t mappedSize = sidecarStat.st_size;
+    struct lineIndexHeader *header = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, sidecarFd, 0);
+    close(sidecarFd);
+    if (header == MAP_FAILED)
+        return NULL;
+
+    // the sidecar-file must contain exactly one entry per line
+    if (isHeaderValid(header, &fileStat) == false ||
+        header->lineCount != (mappedSize - sizeof(struct lineIndexHeader)) / sizeof(struct lineIndexEntry) ||
+        (mappedSize - sizeof(struct lineIndexHeader)) % sizeof(struct lineIndexEntry) != 0)
+    {
+        munmap(header, mappedSize);
+        return NULL;
+    }
+
+    struct lineIndex *lineIndex = malloc(sizeof(struct lineIndex));
+    if (lineIndex == NULL)
+    {
+        munmap(header, mappedSize);
+        return NULL;
+    }
+
+    lineIndex->isMapped = true;
+    lineIndex->mappedSize = mappedSize;
+    lineIndex->header = header;
+    lineIndex->entries = (struct lineIndexEntry *)(header + 1);
+
+    return lineIndex;
+}
+
+/**
+ * @brief Data structure to store a line-aligned chunk of the indexed file
+ * @details firstEntry is the index of the entry of the first line of the chunk.
+ */
+struct indexChunk
+{
+    size_t start;
+    size_t end;
+    size_t lineCount;
+    size_t firstEntry;
+};
+
+/**
+ * @brief Data structure which is shared between the threads, which build the line-index
+ * @details Thread i processes the chunks i, i + threadCount, i + 2 * threadCount, ...
+ * During the first phase the lines of the chunks are counted, during the second phase
+ * the entries are filled.
+ */
+struct indexBuilder
+{
+    const char *data;
+    size_t size;
+    struct indexChunk *chunks;
+    size_t chunkCount;
+    struct lineIndexEntry *entries;
+    int threadCount;
+    bool isFilling;
+};
+
+/**
+ * @brief Data structure which is passed to each thread
+ */
+struct indexWorker
+{
+    struct indexBuilder *builder;
+    int threadIdx;
+    pthread_t thread;
+};
+
+/**
+ * @brief Counts the lines of a chunk, a last line without linebreak counts as line too
+ *
+ * @param builder Pointer to the shared data of the threads
+ * @param chunk Pointer to the chunk
+ */
+static void countChunk(const struct indexBuilder *builder, struct indexChunk *chunk)
+{
+    chunk->lineCount = countLinebreaks(builder->data + chunk->start, chunk->end - chunk->start);
+    if (chunk->end > chunk->start && builder->data[chunk->end - 1] != '\n')
+        chunk->lineCount++;
+}
+
+/**
+ * @brief Fills the entries of all lines of a chunk
+ *
+ * @param builder Pointer to the shared data of the threads
+ * @param chunk Pointer to the chunk
+ */
+static void fillChunk(const struct indexBuilder *builder, const struct indexChunk *chunk)
+{
+    struct lineReader lineReader;
+    initMemoryLineReader(&lineReader, builder->data + chunk->start, chunk->end - chunk->start);
+
+    const char *line;
+    size_t length;
+    for (size_t i = chunk->firstEntry; readLine(&lineReader, &line, &length) == 1; i++)
+    {
+        builder->entries[i].offset = line - builder->data;
+        builder->entries[i].length = length;
+        builder->entries[i].hash = hashLine(line, length);
+    }
+}
+
+/**
+ * @brief Thread which counts or fills its chunks, depending on the current phase
+ *
+ * @param argument Pointer to the indexWorker of the thread
+ * @return Always NULL
+ */
+static void *indexWorker(void *argument)
+{
+    struct indexWorker *worker = argument;
+    struct indexBuilder *builder = worker->builder;
+
+    for (size_t i = worker->threadIdx; i < builder->chunkCount; i += builder->threadCount)
+    {
+        if (builder->isFilling == true)
+            fillChunk(builder, &builder->chunks[i]);
+        else
+            countChunk(builder, &builder->chunks[i]);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs the current phase with all threads and waits for them. If a thread can't
+ * be started, its chunks are processed by the calling thread instead.
+ *
+ * @param workers Array of the workers, one per thread
+ * @param threadCount Amount of threads
+ */
+static void runIndexPhase(struct indexWorker *workers, int threadCount)
+{
+    bool *isStarted = calloc(threadCount, sizeof(bool));
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        if (isStarted != NULL && pthread_create(&workers[i].thread, NULL, &indexWorker, &workers[i]) == 0)
+            isStarted[i] = true;
+        else
+            indexWorker(&workers[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        if (isStarted != NULL && isStarted[i] == true)
+            pthread_join(workers[i].thread, NULL);
+    }
+
+    free(isStarted);
+}
+
+struct lineIndex *buildLineIndex(int fd, const char *data, size_t size, int threadCount)
+{
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == -1)
+        return NULL;
+
+    // every thread gets several chunks, but a chunk is at least INDEX_CHUNK_SIZE bytes
+    size_t chunkCount = (size_t)threadCount * 4;
+    if (chunkCount > size / INDEX_CHUNK_SIZE)
+        chunkCount = (size / INDEX_CHUNK_SIZE > 0) ? size / INDEX_CHUNK_SIZE : 1;
+
+    struct indexBuilder builder = {data, size, calloc(chunkCount, sizeof(struct indexChunk)), chunkCount, NULL, threadCount, false};
+    struct indexWorker *workers = malloc(threadCount * sizeof(struct indexWorker));
+    struct lineIndex *lineIndex = malloc(sizeof(struct lineIndex));
+    struct lineIndexHeader *header = malloc(sizeof(struct lineIndexHeader));
+    if (builder.chunks == NULL || workers == NULL || lineIndex == NULL || header == NULL)
+    {
+        free(builder.chunks);
+        free(workers);
+        free(lineIndex);
+        free(header);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].builder = &builder;
+        workers[i].threadIdx = i;
+    }
+
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        builder.chunks[i].start = (i == 0) ? 0 : builder.chunks[i - 1].end;
+        builder.chunks[i].end = (i == chunkCount - 1) ? size : alignToLineStart(data, size, (i + 1) * (size / chunkCount));
+        if (builder.chunks[i].end < builder.chunks[i].start)
+            builder.chunks[i].end = builder.chunks[i].start;
+    }
+
+    // count the lines of all chunks in parallel, to know where the entries of each chunk start
+    runIndexPhase(workers, threadCount);
+
+    size_t lineCount = 0;
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        builder.chunks[i].firstEntry = lineCount;
+        lineCount += builder.chunks[i].lineCount;
+    }
+
+    builder.entries = malloc((lineCount > 0 ? lineCount : 1) * sizeof(struct lineIndexEntry));
+    if (builder.entries == NULL)
+    {
+        free(builder.chunks);
+        free(workers);
+        free(lineIndex);
+        free(header);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    // fill the entries of all chunks in parallel
+    builder.isFilling = true;
+    runIndexPhase(workers, threadCount);
+
+    memcpy(header->magic, INDEX_MAGIC, sizeof(header->magic));
+    header->version = INDEX_VERSION;
+    header->fileSize = fileStat.st_size;
+    header->device = fileStat.st_dev;
+    header->inode = fileStat.st_ino;
+    header->modificationSeconds = fileStat.st_mtim.tv_sec;
+    header->modificationNanoseconds = fileStat.st_mtim.tv_nsec;
+    header->lineCount = lineCount;
+
+    lineIndex->isMapped = false;
+    lineIndex->mappedSize = 0;
+    lineIndex->header = header;
+    lineIndex->entries = builder.entries;
+
+    free(builder.chunks);
+    free(workers);
+
+    return lineIndex;
+}
+
+/**
+ * @brief Writes the whole memory area to the file, even if write only writes a part of it
+ *
+ * @param fd File descriptor of the file
+ * @param data Pointer to the memory area
+ * @param size Size of the memory area
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int writeAll(int fd, const void *data, size_t size)
+{
+    const char *position = data;
+    while (size > 0)
+    {
+        ssize_t written = write(fd, position, size);
+        if (written == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        position += written;
+        size -= written;
+    }
+
+    return 0;
+}
+
+int saveLineIndex(const struct lineIndex *lineIndex, const char *fileName)
+{
+    char *sidecarName = getSidecarName(fileName, "");
+    char *temporaryName = getSidecarName(fileName, ".tmp");
+    if (sidecarName == NULL || temporaryName == NULL)
+    {
+        free(sidecarName);
+        free(temporaryName);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    int returnValue = -1;
+    int fd = open(temporaryName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd != -1)
+    {
+        if (writeAll(fd, lineIndex->header, sizeof(struct lineIndexHeader)) == 0 &&
+            writeAll(fd, lineIndex->entries, lineIndex->header->lineCount * sizeof(struct lineIndexEntry)) == 0)
+        {
+            returnValue = 0;
+        }
+
+        if (close(fd) == -1)
+            returnValue = -1;
+
+        if (returnValue == 0)
+            returnValue = rename(temporaryName, sidecarName);
+
+        if (returnValue == -1)
+        {
+            // keep errno of the failed call and don't leave the temporary file behind
+            int error = errno;
+            unlink(temporaryName);
+            errno = error;
+        }
+    }
+
+    free(sidecarName);
+    free(temporaryName);
+
+    return returnValue;
+}
+
+const char *getIndexedLine(const struct lineIndex *lineIndex, const struct lineIndexEntry *entry, const char *data)
+{
+    // compared separately, so that a huge length can't overflow the sum
+    uint64_t fileSize = lineIndex->header->fileSize;
+    if (entry->offset > fileSize || entry->length > fileSize - entry->offset)
+        return NULL;
+
+    return data + entry->offset;
+}
+
+uint64_t countIndexedBytes(const struct lineIndex *lineIndex, uint64_t firstLine, uint64_t lastLine)
+{
+    if (firstLine == 0 || firstLine > lastLine)
+        return 0;
+
+    // the range ends at the start of the following line, the last line ends at the end of the file
+    uint64_t fileSize = lineIndex->header->fileSize;
+    uint64_t start = lineIndex->entries[firstLine - 1].offset;
+    uint64_t end = (lastLine < lineIndex->header->lineCount) ? lineIndex->entries[lastLine].offset : fileSize;
+    if (end > fileSize)
+        end = fileSize;
+
+    return (start < end) ? end - start : 0;
+}
+
+void closeLineIndex(struct lineIndex *lineIndex)
+{
+    if (lineIndex->isMapped == true)
+    {
+        munmap(lineIndex->header, lineIndex->mappedSize);
+    }
+    else
+    {
+        free(lineIndex->header);
+        free(lineIndex->entries);
+    }
+
+    free(lineIndex);
+}
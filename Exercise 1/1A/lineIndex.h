@@ -0,0 +1,156 @@
+/**
+ * @file lineIndex.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines build/load/save/close for the line-index.
+ *
+ * This module defines the structure of the line-index and the functions
+ * concerning it. The line-index stores the offset, the length and the hash
+ * of every line of a file. It is saved next to the file (sidecar-file with
+ * the suffix INDEX_SUFFIX) and is only used again as long as the size, the
+ * modification-time, the device and the inode of the file are unchanged. The
+ * entries are not checked against the file when the line-index is loaded, so
+ * the lines of the file are only read through getIndexedLine.
+ */
+
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Suffix which is appended to the filename for the sidecar-file
+ */
+#define INDEX_SUFFIX ".idx"
+
+/**
+ * @brief Minimal size of a chunk in bytes, which is indexed by one thread at once
+ */
+#define INDEX_CHUNK_SIZE (1 << 20)
+
+/**
+ * @brief Magic number at the start of every sidecar-file
+ */
+#define INDEX_MAGIC "MYDIFIDX"
+
+/**
+ * @brief Version of the layout of the sidecar-file
+ */
+#define INDEX_VERSION 2
+
+/**
+ * @brief Datatype of the header of the sidecar-file
+ * @details The size, modification-time, device and inode belong to the file, which is indexed.
+ */
+struct lineIndexHeader
+{
+    char magic[8];
+    uint64_t version;
+    uint64_t fileSize;
+    int64_t modificationSeconds;
+    int64_t modificationNanoseconds;
+    uint64_t device;
+    uint64_t inode;
+    uint64_t lineCount;
+};
+
+/**
+ * @brief Datatype of an entry of the line-index, one entry per line
+ * @details The length doesn't contain the linebreak.
+ */
+struct lineIndexEntry
+{
+    uint64_t offset;
+    uint64_t length;
+    uint64_t hash;
+};
+
+/**
+ * @brief Datatype of the line-index
+ * @details If the line-index is loaded from the sidecar-file, the header and the
+ * entries point to the mapped sidecar-file, otherwise they are allocated.
+ */
+struct lineIndex
+{
+    bool isMapped;
+    size_t mappedSize;
+    struct lineIndexHeader *header;
+    struct lineIndexEntry *entries;
+};
+
+/**
+ * @brief This function loads the line-index of the specified file from its sidecar-file.
+ * Only the header is checked, so loading doesn't read the file or the entries.
+ * @details NULL is also returned if the sidecar-file doesn't exist, has the wrong size or
+ * doesn't belong to the current version of the file (size, modification-time, device or
+ * inode changed).
+ *
+ * @param fileName The filename/path of the indexed file (not of the sidecar-file)
+ * @param fd File descriptor of the already opened indexed file
+ * @return Pointer to the loaded line-index, or NULL if no valid line-index exists
+ */
+struct lineIndex *loadLineIndex(const char *fileName, int fd);
+
+/**
+ * @brief This function builds the line-index of the specified file, which is mapped
+ * into memory. The file is split into line-aligned chunks, whose lines are counted
+ * and indexed by the specified amount of threads. The size and modification-time are
+ * taken from the file descriptor.
+ * @details The data has to be the whole content of the file.
+ *
+ * @param fd File descriptor of the indexed file
+ * @param data Pointer to the mapped content of the file
+ * @param size Size of the file
+ * @param threadCount Amount of threads, which build the line-index (at least 1)
+ * @return Pointer to the built line-index, or NULL if an error occured (errno is set)
+ */
+struct lineIndex *buildLineIndex(int fd, const char *data, size_t size, int threadCount);
+
+/**
+ * @brief This function saves the line-index to the sidecar-file of the specified file.
+ * The sidecar-file is written under a temporary name first and renamed afterwards,
+ * so that other processes never load a partially written line-index.
+ *
+ * @param lineIndex Pointer to the line-index which should be saved
+ * @param fileName The filename/path of the indexed file (not of the sidecar-file)
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int saveLineIndex(const struct lineIndex *lineIndex, const char *fileName);
+
+/**
+ * @brief This function returns the first character of the line of the entry in the indexed file.
+ * @details The entries of a loaded sidecar-file aren't checked (see loadLineIndex), so a damaged
+ * sidecar-file with a valid header could point outside of the file. Such an entry returns NULL
+ * instead of a pointer, whose access raises SIGBUS.
+ *
+ * @param lineIndex Pointer to the line-index
+ * @param entry Pointer to the entry of the line
+ * @param data Pointer to the mapped content of the indexed file
+ * @return Pointer to the line, or NULL if the entry lies outside of the file
+ */
+const char *getIndexedLine(const struct lineIndex *lineIndex, const struct lineIndexEntry *entry, const char *data);
+
+/**
+ * @brief This function returns the amount of bytes of the lines firstLine to lastLine (including
+ * their linebreaks) of the indexed file, without reading the file.
+ * @details Offsets of a damaged sidecar-file are limited to the size of the file.
+ *
+ * @param lineIndex Pointer to the line-index
+ * @param firstLine Number of the first line (starting at 1)
+ * @param lastLine Number of the last line (at most the amount of lines of the file)
+ * @return The amount of bytes, or 0 if firstLine is greater than lastLine
+ */
+uint64_t countIndexedBytes(const struct lineIndex *lineIndex, uint64_t firstLine, uint64_t lastLine);
+
+/**
+ * @brief This function unmaps/frees the line-index.
+ * @details The line-index should not be used after returning from this call.
+ *
+ * @param lineIndex Pointer to the line-index which should be closed
+ */
+void closeLineIndex(struct lineIndex *lineIndex);
+
+#endif
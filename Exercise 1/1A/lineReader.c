@@ -0,0 +1,711 @@
+/**
+ * @file lineReader.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to open/close the line-reader
+ * and to read lines from it.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "diffKernel.h"
+#include "lineReader.h"
+
+/**
+ * @brief Data structure to store the state of the read-ahead thread
+ * @details The blocks are used as ring-buffer: the line-reader reads the block next (of which
+ * consumed bytes are already handed out or copied), the read-ahead thread fills the block
+ * next + filled. isCounted is true, if the block next was already counted by the line-reader.
+ * filled, isWaiting, isStopped, isFinished and error are protected by the mutex. isFinished
+ * is set, as soon as the end of the file is reached or reading fails (error is the errno
+ * of the failed call, errno is thread-local).
+ */
+struct readAhead
+{
+    int fd;
+    char *blocks[READ_AHEAD_COUNT];
+    size_t lengths[READ_AHEAD_COUNT];
+    size_t next;
+    size_t consumed;
+    bool isCounted;
+    size_t filled;
+    bool isWaiting;
+    bool isStopped;
+    bool isFinished;
+    int error;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t blockFilled;
+    pthread_cond_t blockFreed;
+};
+
+/**
+ * @brief Passes the filled block to the line-reader and marks the read-ahead as finished, if the
+ * end of the file is reached or reading failed
+ *
+ * @param readAhead Pointer to the state of the read-ahead thread
+ * @param slot Index of the filled block
+ * @param length Amount of bytes in the block (if 0, the block isn't passed)
+ * @param isFinished Flag if no more blocks follow
+ * @param error errno of the failed read or 0
+ */
+static void passBlock(struct readAhead *readAhead, size_t slot, size_t length, bool isFinished, int error)
+{
+    pthread_mutex_lock(&readAhead->mutex);
+
+    if (length > 0)
+    {
+        readAhead->lengths[slot] = length;
+        readAhead->filled++;
+    }
+
+    readAhead->isFinished = isFinished;
+    readAhead->error = error;
+
+    pthread_cond_signal(&readAhead->blockFilled);
+    pthread_mutex_unlock(&readAhead->mutex);
+}
+
+/**
+ * @brief Function of the read-ahead thread, which fills the free blocks with the file
+ * @details A block is passed to the line-reader, as soon as it is full, or if the line-reader
+ * already waits for it. The thread can only be cancelled while it is blocked in read, so
+ * that it never gets cancelled while holding the mutex.
+ *
+ * @param argument Pointer to the state of the read-ahead thread
+ * @return NULL
+ */
+static void *readAheadWorker(void *argument)
+{
+    struct readAhead *readAhead = argument;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+    for (size_t slot = 0;; slot = (slot + 1) % READ_AHEAD_COUNT)
+    {
+        pthread_mutex_lock(&readAhead->mutex);
+        while (readAhead->filled == READ_AHEAD_COUNT && readAhead->isStopped == false)
+            pthread_cond_wait(&readAhead->blockFreed, &readAhead->mutex);
+
+        bool isStopped = readAhead->isStopped;
+        pthread_mutex_unlock(&readAhead->mutex);
+
+        if (isStopped == true)
+            return NULL;
+
+        size_t length = 0;
+        bool isWaiting = false;
+        while (length < READ_BLOCK_SIZE && isWaiting == false)
+        {
+            pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+            ssize_t bytesRead = read(readAhead->fd, readAhead->blocks[slot] + length, READ_BLOCK_SIZE - length);
+            pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+            if (bytesRead == -1 && errno == EINTR)
+                continue;
+            if (bytesRead <= 0)
+            {
+                passBlock(readAhead, slot, length, true, (bytesRead == -1) ? errno : 0);
+                return NULL;
+            }
+
+            length += bytesRead;
+
+            pthread_mutex_lock(&readAhead->mutex);
+            isWaiting = readAhead->isWaiting;
+            pthread_mutex_unlock(&readAhead->mutex);
+        }
+
+        passBlock(readAhead, slot, length, false, 0);
+    }
+}
+
+/**
+ * @brief Frees the blocks and the synchronisation primitives of the read-ahead thread
+ *
+ * @param readAhead Pointer to the state of the read-ahead thread
+ */
+static void freeReadAhead(struct readAhead *readAhead)
+{
+    pthread_mutex_destroy(&readAhead->mutex);
+    pthread_cond_destroy(&readAhead->blockFilled);
+    pthread_cond_destroy(&readAhead->blockFreed);
+
+    for (size_t i = 0; i < READ_AHEAD_COUNT; i++)
+        free(readAhead->blocks[i]);
+
+    free(readAhead);
+}
+
+/**
+ * @brief Starts the read-ahead thread for the file of the line-reader
+ *
+ * @param fd File descriptor of the file
+ * @return Pointer to the state of the read-ahead thread or NULL, if it couldn't be started
+ */
+static struct readAhead *startReadAhead(int fd)
+{
+    struct readAhead *readAhead = calloc(1, sizeof(struct readAhead));
+    if (readAhead == NULL)
+        return NULL;
+
+    readAhead->fd = fd;
+    pthread_mutex_init(&readAhead->mutex, NULL);
+    pthread_cond_init(&readAhead->blockFilled, NULL);
+    pthread_cond_init(&readAhead->blockFreed, NULL);
+
+    for (size_t i = 0; i < READ_AHEAD_COUNT; i++)
+    {
+        if ((readAhead->blocks[i] = malloc(READ_BLOCK_SIZE)) == NULL)
+        {
+            freeReadAhead(readAhead);
+            return NULL;
+        }
+    }
+
+    if (pthread_create(&readAhead->thread, NULL, &readAheadWorker, readAhead) != 0)
+    {
+        freeReadAhead(readAhead);
+        return NULL;
+    }
+
+    return readAhead;
+}
+
+/**
+ * @brief Stops the read-ahead thread, even if it is blocked in read, and frees its state
+ *
+ * @param readAhead Pointer to the state of the read-ahead thread
+ */
+static void stopReadAhead(struct readAhead *readAhead)
+{
+    pthread_mutex_lock(&readAhead->mutex);
+    readAhead->isStopped = true;
+    pthread_cond_signal(&readAhead->blockFreed);
+    pthread_mutex_unlock(&readAhead->mutex);
+
+    pthread_cancel(readAhead->thread);
+    pthread_join(readAhead->thread, NULL);
+
+    freeReadAhead(readAhead);
+}
+
+/**
+ * @brief Returns the bytes of the oldest block of the read-ahead thread, which aren't consumed yet.
+ * Waits, if the read-ahead thread hasn't filled a block yet. A block is counted in the statistics
+ * of the line-reader, when it is returned for the first time.
+ * @details A completely consumed block is only passed back to the read-ahead thread by the next
+ * call, so that a line, which was handed out directly from the block, stays valid until then.
+ *
+ * @param lineReader Pointer to the line-reader with a read-ahead thread
+ * @param data Pointer which will be set to the first unconsumed byte of the block
+ * @param length Pointer which will be set to the amount of unconsumed bytes of the block
+ * @return 1 if a block was returned, 0 at the end of the file and -1 on error (errno is set)
+ */
+static int peekAhead(struct lineReader *lineReader, const char **data, size_t *length)
+{
+    struct readAhead *readAhead = lineReader->readAhead;
+    size_t next = readAhead->next;
+
+    // the rest of the current block belongs to the line-reader, so the mutex isn't needed
+    if (readAhead->isCounted == true && readAhead->consumed < readAhead->lengths[next])
+    {
+        *data = readAhead->blocks[next] + readAhead->consumed;
+        *length = readAhead->lengths[next] - readAhead->consumed;
+        return 1;
+    }
+
+    if (readAhead->isCounted == true)
+    {
+        readAhead->next = next = (next + 1) % READ_AHEAD_COUNT;
+        readAhead->consumed = 0;
+        readAhead->isCounted = false;
+
+        pthread_mutex_lock(&readAhead->mutex);
+        readAhead->filled--;
+        pthread_cond_signal(&readAhead->blockFreed);
+        pthread_mutex_unlock(&readAhead->mutex);
+    }
+
+    pthread_mutex_lock(&readAhead->mutex);
+
+    readAhead->isWaiting = true;
+    while (readAhead->filled == 0 && readAhead->isFinished == false)
+        pthread_cond_wait(&readAhead->blockFilled, &readAhead->mutex);
+    readAhead->isWaiting = false;
+
+    bool isEmpty = readAhead->filled == 0;
+    int error = readAhead->error;
+    pthread_mutex_unlock(&readAhead->mutex);
+
+    if (isEmpty == true)
+    {
+        errno = error;
+        return (error != 0) ? -1 : 0;
+    }
+
+    // the read-ahead thread never writes into a filled block, so it is read without the mutex
+    const char *block = readAhead->blocks[next];
+    size_t blockLength = readAhead->lengths[next];
+    if (readAhead->isCounted == false)
+    {
+        lineReader->bytesRead += blockLength;
+        lineReader->linebreaksRead += countLinebreaks(block, blockLength);
+        lineReader->isLineOpen = block[blockLength - 1] != '\n';
+        readAhead->isCounted = true;
+    }
+
+    *data = block + readAhead->consumed;
+    *length = blockLength - readAhead->consumed;
+
+    return 1;
+}
+
+/**
+ * @brief Copies the next bytes, which the read-ahead thread has read, into the memory area.
+ * Waits, if the read-ahead thread hasn't filled a block yet.
+ *
+ * @param lineReader Pointer to the line-reader with a read-ahead thread
+ * @param target Pointer to the memory area
+ * @param size Size of the memory area
+ * @return The amount of copied bytes, 0 at the end of the file or -1 on error (like read)
+ */
+static ssize_t takeBlock(struct lineReader *lineReader, char *target, size_t size)
+{
+    const char *data;
+    size_t length;
+    int status = peekAhead(lineReader, &data, &length);
+    if (status != 1)
+        return status;
+
+    if (length > size)
+        length = size;
+
+    memcpy(target, data, length);
+    lineReader->readAhead->consumed += length;
+
+    return length;
+}
+
+/**
+ * @brief Maps the whole regular file into memory
+ * @details mmap doesn't support empty mappings, so an empty file counts as mapped
+ * with an empty buffer (capacity 0), which isn't unmapped.
+ *
+ * @param lineReader Pointer to the line-reader, whose file should be mapped
+ * @param fileStat Pointer to the status of the regular file
+ * @return true if the file is mapped, false if it has to be read in blocks
+ */
+static bool mapFile(struct lineReader *lineReader, const struct stat *fileStat)
+{
+    static const char emptyContent[1] = "";
+
+    // an empty file needs neither a mapping nor the read-ahead thread and its blocks
+    if (fileStat->st_size == 0)
+    {
+        lineReader->isMapped = true;
+        lineReader->buffer = (char *)emptyContent;
+        lineReader->capacity = 0;
+        lineReader->isEOF = true;
+        return true;
+    }
+
+    // mmap can't map more than the address space
+    if ((uintmax_t)fileStat->st_size > SIZE_MAX)
+        return false;
+
+    size_t size = fileStat->st_size;
+    char *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, lineReader->fd, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    // only hints, which are ignored if the kernel doesn't support them
+    madvise(mapping, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(mapping, size, MADV_HUGEPAGE);
+#endif
+
+    lineReader->isMapped = true;
+    lineReader->buffer = mapping;
+    lineReader->capacity = size;
+    lineReader->end = size;
+    lineReader->isEOF = true;
+
+    return true;
+}
+
+struct lineReader *openLineReader(int fd)
+{
+    struct lineReader *lineReader = malloc(sizeof(struct lineReader));
+    if (lineReader == NULL)
+        return NULL;
+
+    lineReader->fd = fd;
+    lineReader->isMapped = false;
+    lineReader->readAhead = NULL;
+    lineReader->start = 0;
+    lineReader->end = 0;
+    lineReader->isEOF = false;
+    lineReader->bytesRead = 0;
+    lineReader->linebreaksRead = 0;
+    lineReader->isLineOpen = false;
+
+    struct stat fileStat;
+    bool isRegular = fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+    if (isRegular == true && mapFile(lineReader, &fileStat) == true)
+        return lineReader;
+
+    // fall back to reading the file in blocks
+    lineReader->buffer = malloc(READ_BLOCK_SIZE);
+    if (lineReader->buffer == NULL)
+    {
+        free(lineReader);
+        return NULL;
+    }
+
+    lineReader->capacity = READ_BLOCK_SIZE;
+
+    // without the read-ahead thread, the blocks are read directly (always for a regular file, which can't be mapped)
+    if (isRegular == false)
+        lineReader->readAhead = startReadAhead(fd);
+
+    return lineReader;
+}
+
+void initMemoryLineReader(struct lineReader *lineReader, const char *data, size_t length)
+{
+    lineReader->fd = -1;
+    lineReader->isMapped = false;
+    lineReader->readAhead = NULL;
+    lineReader->buffer = (char *)data;
+    lineReader->capacity = length;
+    lineReader->start = 0;
+    lineReader->end = length;
+    lineReader->isEOF = true;
+    lineReader->bytesRead = 0;
+    lineReader->linebreaksRead = 0;
+    lineReader->isLineOpen = false;
+}
+
+size_t alignToLineStart(const char *data, size_t size, size_t position)
+{
+    if (position == 0 || position >= size)
+        return (position == 0) ? 0 : size;
+
+    // a line starts at the position, if the character before is a linebreak
+    const char *linebreak = memchr(data + position - 1, '\n', size - position + 1);
+
+    return (linebreak == NULL) ? size : (size_t)(linebreak - data) + 1;
+}
+
+void closeLineReader(struct lineReader *lineReader)
+{
+    if (lineReader->readAhead != NULL)
+        stopReadAhead(lineReader->readAhead);
+
+    if (lineReader->isMapped == true && lineReader->capacity > 0)
+        munmap(lineReader->buffer, lineReader->capacity);
+    else if (lineReader->isMapped == false)
+        free(lineReader->buffer);
+
+    free(lineReader);
+}
+
+/**
+ * @brief Moves the unread bytes to the beginning of the buffer and fills the rest
+ * of the buffer with the next block of the file (from the read-ahead thread, if it runs). If the buffer is completely filled
+ * with one line, the buffer gets doubled.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @return 0 on success and -1 on error
+ */
+static int fillBuffer(struct lineReader *lineReader)
+{
+    size_t unread = lineReader->end - lineReader->start;
+
+    if (lineReader->start > 0)
+    {
+        memmove(lineReader->buffer, lineReader->buffer + lineReader->start, unread);
+        lineReader->start = 0;
+        lineReader->end = unread;
+    }
+    else if (unread == lineReader->capacity)
+    {
+        char *buffer = realloc(lineReader->buffer, lineReader->capacity * 2);
+        if (buffer == NULL)
+            return -1;
+
+        lineReader->buffer = buffer;
+        lineReader->capacity *= 2;
+    }
+
+    char *target = lineReader->buffer + lineReader->end;
+    size_t size = lineReader->capacity - lineReader->end;
+
+    ssize_t bytesRead;
+    do
+    {
+        if (lineReader->readAhead != NULL)
+            bytesRead = takeBlock(lineReader, target, size);
+        else
+            bytesRead = read(lineReader->fd, target, size);
+    } while (bytesRead == -1 && errno == EINTR);
+
+    if (bytesRead == -1)
+        return -1;
+
+    // the blocks of the read-ahead thread are already counted by peekAhead
+    if (bytesRead == 0)
+    {
+        lineReader->isEOF = true;
+    }
+    else if (lineReader->readAhead == NULL)
+    {
+        lineReader->bytesRead += bytesRead;
+        lineReader->linebreaksRead += countLinebreaks(target, bytesRead);
+        lineReader->isLineOpen = target[bytesRead - 1] != '\n';
+    }
+
+    lineReader->end += bytesRead;
+
+    return 0;
+}
+
+/**
+ * @brief Appends the memory area to the unread bytes in the buffer. The unread bytes are moved
+ * to the beginning of the buffer first and the buffer is doubled, until the memory area fits.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @param data Pointer to the first character of the memory area
+ * @param length Length of the memory area
+ * @return 0 on success and -1 on error
+ */
+static int appendToBuffer(struct lineReader *lineReader, const char *data, size_t length)
+{
+    size_t unread = lineReader->end - lineReader->start;
+    if (lineReader->start > 0)
+    {
+        memmove(lineReader->buffer, lineReader->buffer + lineReader->start, unread);
+        lineReader->start = 0;
+        lineReader->end = unread;
+    }
+
+    size_t capacity = lineReader->capacity;
+    while (capacity - unread < length)
+        capacity *= 2;
+
+    if (capacity > lineReader->capacity)
+    {
+        char *buffer = realloc(lineReader->buffer, capacity);
+        if (buffer == NULL)
+            return -1;
+
+        lineReader->buffer = buffer;
+        lineReader->capacity = capacity;
+    }
+
+    memcpy(lineReader->buffer + lineReader->end, data, length);
+    lineReader->end += length;
+
+    return 0;
+}
+
+/**
+ * @brief Returns the next line of a line-reader with a read-ahead thread. A line, which lies
+ * completely inside a block of the read-ahead thread, is handed out directly from the block.
+ * Only a line, which crosses the end of a block, is collected in the buffer.
+ *
+ * @param lineReader Pointer to the line-reader with a read-ahead thread
+ * @param line Pointer which will be set to the first character of the line
+ * @param length Pointer which will be set to the length of the line
+ * @return 1 if a line was read, 0 if the end of the file is reached and -1 on error
+ */
+static int readLineAhead(struct lineReader *lineReader, const char **line, size_t *length)
+{
+    // the buffer can still contain complete lines, if readBlock was called before
+    char *linebreak = memchr(lineReader->buffer + lineReader->start, '\n', lineReader->end - lineReader->start);
+    if (linebreak != NULL)
+    {
+        *line = lineReader->buffer + lineReader->start;
+        *length = linebreak - *line;
+        lineReader->start += *length + 1;
+        return 1;
+    }
+
+    while (true)
+    {
+        const char *data;
+        size_t available;
+        int status = peekAhead(lineReader, &data, &available);
+        if (status == -1)
+            return -1;
+
+        if (status == 0)
+        {
+            // the last line is not terminated with a linebreak
+            lineReader->isEOF = true;
+            if (lineReader->start == lineReader->end)
+                return 0;
+
+            *line = lineReader->buffer + lineReader->start;
+            *length = lineReader->end - lineReader->start;
+            lineReader->start = lineReader->end;
+            return 1;
+        }
+
+        const char *blockLinebreak = memchr(data, '\n', available);
+        size_t taken = (blockLinebreak != NULL) ? (size_t)(blockLinebreak - data) + 1 : available;
+        lineReader->readAhead->consumed += taken;
+
+        if (blockLinebreak != NULL && lineReader->start == lineReader->end)
+        {
+            *line = data;
+            *length = taken - 1;
+            return 1;
+        }
+
+        // the line started in an earlier block, so its parts are collected in the buffer
+        if (appendToBuffer(lineReader, data, taken) == -1)
+            return -1;
+
+        if (blockLinebreak != NULL)
+        {
+            *line = lineReader->buffer + lineReader->start;
+            *length = lineReader->end - lineReader->start - 1;
+            lineReader->start = lineReader->end;
+            return 1;
+        }
+    }
+}
+
+int readLine(struct lineReader *lineReader, const char **line, size_t *length)
+{
+    if (lineReader->readAhead != NULL)
+        return readLineAhead(lineReader, line, length);
+
+    size_t searchFrom = lineReader->start;
+
+    while (true)
+    {
+        char *linebreak = memchr(lineReader->buffer + searchFrom, '\n', lineReader->end - searchFrom);
+        if (linebreak != NULL)
+        {
+            *line = lineReader->buffer + lineReader->start;
+            *length = linebreak - *line;
+            lineReader->start += *length + 1;
+            return 1;
+        }
+
+        if (lineReader->isEOF == true)
+        {
+            // the last line is not terminated with a linebreak
+            if (lineReader->start == lineReader->end)
+                return 0;
+
+            *line = lineReader->buffer + lineReader->start;
+            *length = lineReader->end - lineReader->start;
+            lineReader->start = lineReader->end;
+            return 1;
+        }
+
+        // continue the search after the bytes which are already searched
+        size_t searched = lineReader->end - lineReader->start;
+        if (fillBuffer(lineReader) == -1)
+            return -1;
+
+        searchFrom = lineReader->start + searched;
+    }
+}
+
+int readBlock(struct lineReader *lineReader, const char **block, size_t *length)
+{
+    while (true)
+    {
+        size_t unread = lineReader->end - lineReader->start;
+        size_t windowEnd = lineReader->start + ((unread > READ_BLOCK_SIZE) ? READ_BLOCK_SIZE : unread);
+
+        // the block ends after the last linebreak of the window, or after the next one for a longer line
+        size_t blockEnd = windowEnd;
+        while (blockEnd > lineReader->start && lineReader->buffer[blockEnd - 1] != '\n')
+            blockEnd--;
+
+        if (blockEnd == lineReader->start)
+            blockEnd = alignToLineStart(lineReader->buffer, lineReader->end, windowEnd);
+
+        if (blockEnd > lineReader->start && lineReader->buffer[blockEnd - 1] == '\n')
+        {
+            *block = lineReader->buffer + lineReader->start;
+            *length = blockEnd - lineReader->start;
+            lineReader->start = blockEnd;
+            return 1;
+        }
+
+        if (lineReader->isEOF == true)
+        {
+            // the last line is not terminated with a linebreak
+            if (lineReader->start == lineReader->end)
+                return 0;
+
+            *block = lineReader->buffer + lineReader->start;
+            *length = lineReader->end - lineReader->start;
+            lineReader->start = lineReader->end;
+            return 1;
+        }
+
+        if (fillBuffer(lineReader) == -1)
+            return -1;
+    }
+}
+
+int readRemaining(struct lineReader *lineReader, const char **data, size_t *length)
+{
+    // the buffer is doubled whenever it is full, so that it finally contains the whole rest
+    while (lineReader->isEOF == false)
+    {
+        if (fillBuffer(lineReader) == -1)
+            return -1;
+    }
+
+    *data = lineReader->buffer + lineReader->start;
+    *length = lineReader->end - lineReader->start;
+    lineReader->start = lineReader->end;
+
+    return 0;
+}
+
+void countReadInput(const struct lineReader *lineReader, uint64_t *lines, uint64_t *bytes)
+{
+    if (lineReader->isMapped == true || lineReader->fd == -1)
+    {
+        *bytes = lineReader->end;
+        *lines = countLinebreaks(lineReader->buffer, lineReader->end);
+        if (lineReader->end > 0 && lineReader->buffer[lineReader->end - 1] != '\n')
+            (*lines)++;
+        return;
+    }
+
+    // a last line without linebreak counts as line too
+    *bytes = lineReader->bytesRead;
+    *lines = lineReader->linebreaksRead + ((lineReader->isLineOpen == true) ? 1 : 0);
+}
+
+uint64_t countConsumedBytes(const struct lineReader *lineReader)
+{
+    if (lineReader->isMapped == true || lineReader->fd == -1)
+        return lineReader->start;
+
+    // the bytes between start and end and the rest of a counted block are read, but not handed out yet
+    uint64_t unread = lineReader->end - lineReader->start;
+    struct readAhead *readAhead = lineReader->readAhead;
+    if (readAhead != NULL && readAhead->isCounted == true)
+        unread += readAhead->lengths[readAhead->next] - readAhead->consumed;
+
+    return lineReader->bytesRead - unread;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file lineReader.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines open/close/read for the block-buffered line-reader.
+ *
+ * This module defines the structure for the line-reader and the functions
+ * concerning it. Regular files are mapped into memory and the lines are
+ * handed out directly from the mapped pages. Pipes, FIFOs and other files
+ * which can't be mapped are read in large blocks by a read-ahead thread
+ * into READ_AHEAD_COUNT rotating buffers instead, so the comparison overlaps
+ * with the reading and the process on the other end of a pipe doesn't have
+ * to wait for the comparison. readLine hands out the lines directly from these
+ * buffers, only a line which crosses the end of a buffer is copied. In both
+ * cases no character has to be read on its own.
+ */
+
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of a block, which is read from the file at once
+ */
+#define READ_BLOCK_SIZE (1 << 20)
+
+/**
+ * @brief Amount of blocks, which the read-ahead thread can read ahead of the line-reader
+ */
+#define READ_AHEAD_COUNT 4
+
+/**
+ * @brief Datatype of the read-ahead thread of a line-reader (defined in lineReader.c)
+ */
+struct readAhead;
+
+/**
+ * @brief Datatype of the line-reader
+ * @details The bytes between start and end are read from the file,
+ * but not handed out as line yet. If the file is mapped, the buffer
+ * points to the mapped pages and already contains the whole file.
+ * Otherwise the blocks are taken from the read-ahead thread, or read
+ * directly, if readAhead is NULL. With the read-ahead thread, readLine
+ * only copies the start of a line, which crosses the end of a block,
+ * into the buffer. bytesRead and linebreaksRead count the
+ * bytes and linebreaks of all read blocks, isLineOpen is true, if the last
+ * read block doesn't end with a linebreak.
+ */
+struct lineReader
+{
+    int fd;
+    bool isMapped;
+    struct readAhead *readAhead;
+    char *buffer;
+    size_t capacity;
+    size_t start;
+    size_t end;
+    bool isEOF;
+    uint64_t bytesRead;
+    uint64_t linebreaksRead;
+    bool isLineOpen;
+};
+
+/**
+ * @brief This function creates a line-reader for the specified file. If the file
+ * is a regular file, it gets mapped into memory with the hint that it is read
+ * sequentially (and with huge pages, if the kernel supports it). An empty regular
+ * file counts as mapped with an empty buffer. Otherwise a read-ahead thread is started,
+ * which reads the file in blocks of READ_BLOCK_SIZE (the blocks are read directly, if
+ * the thread can't be started or the file is a regular file, whose mapping failed).
+ * @details The file descriptor has to stay open as long as the line-reader is used.
+ * A mapped file must not be truncated while it is read, otherwise SIGBUS is raised.
+ *
+ * @param fd File descriptor of the already opened input-file
+ * @return Pointer to a line-reader, if the creation was successfull, otherwise NULL
+ */
+struct lineReader *openLineReader(int fd);
+
+/**
+ * @brief This function initializes a line-reader, which returns the lines of the
+ * specified memory area (e.g. a part of a mapped file).
+ * @details The memory area has to stay valid as long as the line-reader is used. The
+ * line-reader isn't allocated and therefore must not be closed with closeLineReader.
+ *
+ * @param lineReader Pointer to the line-reader which should be initialized
+ * @param data Pointer to the first character of the memory area
+ * @param length Length of the memory area
+ */
+void initMemoryLineReader(struct lineReader *lineReader, const char *data, size_t length);
+
+/**
+ * @brief This function returns the offset of the first line, which starts at or after
+ * the specified position in the memory area.
+ *
+ * @param data Pointer to the first character of the memory area
+ * @param size Size of the memory area
+ * @param position Position, from which the next line start should be found
+ * @return Offset of the line start, or size if no line starts after the position
+ */
+size_t alignToLineStart(const char *data, size_t size, size_t position);
+
+/**
+ * @brief This function unmaps/frees the line-reader and stops its read-ahead thread.
+ * The file itself is not closed.
+ * @details The line-reader should not be used after returning from this call.
+ *
+ * @param lineReader Pointer to the line-reader which should be closed
+ */
+void closeLineReader(struct lineReader *lineReader);
+
+/**
+ * @brief This function returns the next line of the file without the linebreak.
+ * If the file doesn't end with a linebreak, the remaining characters are returned
+ * as the last line.
+ * @details The returned line is not null-terminated and is only valid until the
+ * next call of this function.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @param line Pointer which will be set to the first character of the line
+ * @param length Pointer which will be set to the length of the line
+ * @return 1 if a line was read, 0 if the end of the file is reached and -1 on error
+ */
+int readLine(struct lineReader *lineReader, const char **line, size_t *length);
+
+/**
+ * @brief This function returns the next block of complete lines of the file. A block
+ * contains about READ_BLOCK_SIZE bytes (at least one line) and ends after a linebreak,
+ * or at the end of the file.
+ * @details The returned block is only valid until the next call of readLine or readBlock.
+ * The lines of the block can be read with a line-reader from initMemoryLineReader.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @param block Pointer which will be set to the first character of the block
+ * @param length Pointer which will be set to the length of the block
+ * @return 1 if a block was read, 0 if the end of the file is reached and -1 on error
+ */
+int readBlock(struct lineReader *lineReader, const char **block, size_t *length);
+
+/**
+ * @brief This function returns all characters of the file, which are not read yet. If the
+ * file isn't mapped, it is read into the buffer of the line-reader until its end.
+ * @details The returned characters are valid until the line-reader is closed.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @param data Pointer which will be set to the first unread character
+ * @param length Pointer which will be set to the amount of unread characters
+ * @return 0 on success and -1 on error
+ */
+int readRemaining(struct lineReader *lineReader, const char **data, size_t *length);
+
+/**
+ * @brief This function returns the amount of lines and bytes, which were read from the file so
+ * far. A mapped file (or a memory area) counts as completely read.
+ *
+ * @param lineReader Pointer to the line-reader
+ * @param lines Pointer which will be set to the amount of read lines
+ * @param bytes Pointer which will be set to the amount of read bytes
+ */
+void countReadInput(const struct lineReader *lineReader, uint64_t *lines, uint64_t *bytes);
+
+/**
+ * @brief This function returns the amount of bytes, which were handed out as lines or blocks so
+ * far (unlike countReadInput, the rest of a mapped file and read ahead bytes don't count).
+ *
+ * @param lineReader Pointer to the line-reader
+ * @return The amount of handed out bytes
+ */
+uint64_t countConsumedBytes(const struct lineReader *lineReader);
+
+#endif
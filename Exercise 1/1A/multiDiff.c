@@ -0,0 +1,305 @@
+/**
+ * @file multiDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the comparison of several files with one reference-file.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "lineDiff.h"
+#include "multiDiff.h"
+
+/**
+ * @brief Data structure to store the state of one compared file
+ * @details The report collects the formatted records of the differing lines in memory.
+ * If isStreamed is true, the report is the output-sink itself, so the records are written
+ * directly while the files are compared (only for the first file, see compareFilesMulti).
+ * A file is finished, as soon as it ends or an error occurs. The error is the errno
+ * of the failed call (errno is thread-local) or 0.
+ */
+struct input
+{
+    struct lineReader *lineReader;
+    struct lineReport report;
+    bool isStreamed;
+    bool isFinished;
+    int error;
+};
+
+/**
+ * @brief Data structure which is shared between all threads
+ * @details The block of the reference-file, its status and the generation are protected
+ * by the mutex. The generation is increased for every block, pending is the amount of
+ * worker-threads, which haven't finished the current block yet.
+ */
+struct multiDiff
+{
+    struct input *inputs;
+    size_t inputCount;
+    diffKernel kernel;
+    const char *block;
+    size_t blockLength;
+    uint64_t blockFirstLine;
+    int blockStatus;
+    size_t generation;
+    int pending;
+    int partitionCount;
+    pthread_mutex_t mutex;
+    pthread_cond_t blockReady;
+    pthread_cond_t blockDone;
+};
+
+/**
+ * @brief Data structure to pass the shared data and the own partition to a worker-thread
+ */
+struct worker
+{
+    struct multiDiff *diff;
+    int partition;
+};
+
+/**
+ * @brief Compares the lines of the current block with the next lines of the file
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param input Pointer to the state of the compared file
+ */
+static void compareBlock(const struct multiDiff *diff, struct input *input)
+{
+    if (input->isFinished == true)
+        return;
+
+    struct lineReader blockReader;
+    initMemoryLineReader(&blockReader, diff->block, diff->blockLength);
+
+    // the file is finished, if it ends before the block (the report is only opened for files with differences)
+    int status = compareLineReaders(&blockReader, input->lineReader, diff->kernel, diff->blockFirstLine, 1, UINT64_MAX, &input->report);
+    if (status != 0)
+    {
+        input->isFinished = true;
+        input->error = (status == -1) ? errno : 0;
+    }
+}
+
+/**
+ * @brief Compares the current block with all files of the specified partition
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param partition Index of the partition (files with index % partitionCount == partition)
+ */
+static void comparePartition(struct multiDiff *diff, int partition)
+{
+    for (size_t i = partition; i < diff->inputCount; i += diff->partitionCount)
+        compareBlock(diff, &diff->inputs[i]);
+}
+
+/**
+ * @brief Worker-thread which waits for every block of the reference-file, compares it
+ * with the files of its partition and signals the reading thread afterwards
+ *
+ * @param argument Pointer to the worker
+ * @return Always NULL
+ */
+static void *compareWorker(void *argument)
+{
+    struct worker *worker = argument;
+    struct multiDiff *diff = worker->diff;
+    size_t generation = 0;
+
+    while (true)
+    {
+        pthread_mutex_lock(&diff->mutex);
+        while (diff->generation == generation)
+            pthread_cond_wait(&diff->blockReady, &diff->mutex);
+        generation = diff->generation;
+        int blockStatus = diff->blockStatus;
+        pthread_mutex_unlock(&diff->mutex);
+
+        if (blockStatus != 1)
+            break;
+
+        comparePartition(diff, worker->partition);
+
+        pthread_mutex_lock(&diff->mutex);
+        if (--diff->pending == 0)
+            pthread_cond_signal(&diff->blockDone);
+        pthread_mutex_unlock(&diff->mutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Publishes the next block (or the end of the reference-file) to the worker-threads
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param status The status of readBlock
+ */
+static void publishBlock(struct multiDiff *diff, int status)
+{
+    pthread_mutex_lock(&diff->mutex);
+    diff->blockStatus = status;
+    diff->pending = diff->partitionCount - 1;
+    diff->generation++;
+    pthread_cond_broadcast(&diff->blockReady);
+    pthread_mutex_unlock(&diff->mutex);
+}
+
+/**
+ * @brief Reads the reference-file block by block and compares every block together with
+ * the worker-threads, until the reference-file or all files are finished
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param reference Pointer to the line-reader of the reference-file
+ * @return 0 on success and -1 if reading the reference-file failed
+ */
+static int compareBlocks(struct multiDiff *diff, struct lineReader *reference)
+{
+    int status;
+    diff->blockFirstLine = 1;
+
+    while ((status = readBlock(reference, &diff->block, &diff->blockLength)) == 1)
+    {
+        publishBlock(diff, status);
+        comparePartition(diff, 0);
+
+        // the block is only valid until the next call of readBlock
+        pthread_mutex_lock(&diff->mutex);
+        while (diff->pending > 0)
+            pthread_cond_wait(&diff->blockDone, &diff->mutex);
+        pthread_mutex_unlock(&diff->mutex);
+
+        bool isFinished = true;
+        for (size_t i = 0; i < diff->inputCount && isFinished == true; i++)
+            isFinished = diff->inputs[i].isFinished;
+        if (isFinished == true)
+            break;
+
+        // a last line without linebreak is always the end of the reference-file
+        diff->blockFirstLine += countLinebreaks(diff->block, diff->blockLength);
+    }
+
+    publishBlock(diff, 0);
+
+    return (status == -1) ? -1 : 0;
+}
+
+/**
+ * @brief Writes the reports of all files in their order
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param fileNames Array of the filenames/paths of the compared files
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @return The amount of different lines of all files or -1 if a file failed or writing failed
+ */
+static int64_t writeReports(const struct multiDiff *diff, char **fileNames, struct outputSink *outputSink)
+{
+    int64_t differentLines = 0;
+
+    for (size_t i = 0; i < diff->inputCount; i++)
+    {
+        struct input *input = &diff->inputs[i];
+        if (input->error != 0)
+        {
+            errno = input->error;
+            return -1;
+        }
+
+        // the file-header and the records of a streamed file are already written
+        if ((input->isStreamed == false && writeFileHeader(outputSink, fileNames[i], i + 1) == -1) ||
+            (input->isStreamed == false && input->report.output != NULL && moveOutputSink(outputSink, input->report.output) == -1) ||
+            (input->report.differentLines == 0 && writeNoDifferences(outputSink) == -1))
+            return -1;
+
+        differentLines += input->report.differentLines;
+    }
+
+    return differentLines;
+}
+
+int64_t compareFilesMulti(struct lineReader *reference, struct lineReader **lineReaders, char **fileNames, size_t fileCount, struct outputSink *outputSink, diffKernel kernel, int threadCount)
+{
+    struct multiDiff diff;
+    diff.inputCount = fileCount;
+    diff.kernel = kernel;
+    diff.generation = 0;
+    diff.pending = 0;
+
+    if (threadCount < 1)
+        threadCount = 1;
+    if ((size_t)threadCount > fileCount)
+        threadCount = fileCount;
+
+    diff.inputs = calloc(fileCount, sizeof(struct input));
+    pthread_t *threads = malloc(threadCount * sizeof(pthread_t));
+    struct worker *workers = malloc(threadCount * sizeof(struct worker));
+    if (diff.inputs == NULL || threads == NULL || workers == NULL)
+    {
+        free(diff.inputs);
+        free(threads);
+        free(workers);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (size_t i = 0; i < fileCount; i++)
+    {
+        diff.inputs[i].lineReader = lineReaders[i];
+        diff.inputs[i].report.format = outputSink->format;
+    }
+
+    // the first file belongs to the calling thread, which is the only one writing to the output during the comparison
+    if (writeFileHeader(outputSink, fileNames[0], 1) == -1)
+    {
+        free(diff.inputs);
+        free(threads);
+        free(workers);
+        return -1;
+    }
+
+    diff.inputs[0].report.output = outputSink;
+    diff.inputs[0].isStreamed = true;
+
+    pthread_mutex_init(&diff.mutex, NULL);
+    pthread_cond_init(&diff.blockReady, NULL);
+    pthread_cond_init(&diff.blockDone, NULL);
+
+    // the calling thread compares the first partition, if a thread can't be started there are less partitions
+    int started = 0;
+    while (started < threadCount - 1)
+    {
+        workers[started].diff = &diff;
+        workers[started].partition = started + 1;
+        if (pthread_create(&threads[started], NULL, &compareWorker, &workers[started]) != 0)
+            break;
+        started++;
+    }
+    diff.partitionCount = started + 1;
+
+    int64_t differentLines = compareBlocks(&diff, reference);
+
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    if (differentLines != -1)
+        differentLines = writeReports(&diff, fileNames, outputSink);
+
+    for (size_t i = 0; i < fileCount; i++)
+    {
+        if (diff.inputs[i].report.output != NULL && diff.inputs[i].isStreamed == false)
+            closeOutputSink(diff.inputs[i].report.output);
+    }
+
+    pthread_cond_destroy(&diff.blockDone);
+    pthread_cond_destroy(&diff.blockReady);
+    pthread_mutex_destroy(&diff.mutex);
+    free(diff.inputs);
+    free(threads);
+    free(workers);
+
+    return differentLines;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file multiDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the comparison of several files with one reference-file.
+ *
+ * The reference-file is read only once in blocks of complete lines. Every block
+ * is compared with the next lines of all other files, before the next block is
+ * read. The files are distributed over worker-threads. The report of the first
+ * file is written directly to the output, the reports of the other files are
+ * collected in an own buffer per file. At the end those reports are written in
+ * the order of the files, each one starting with a file-header. So the memory
+ * grows with the differences of all files except the first one.
+ */
+
+#ifndef MULTIDIFF_H
+#define MULTIDIFF_H
+
+#include "diffKernel.h"
+#include "lineReader.h"
+#include "outputSink.h"
+
+/**
+ * @brief This function compares every file line by line with the reference-file and writes
+ * for every file a file-header, the differing lines (in the same format as the comparison of
+ * two files) and the message that no differences were found, if the file doesn't differ.
+ * @details The line-readers are read until the end of the shorter file. The reference-file
+ * is read exactly once, so it can also be a pipe. The reports of all files except the first
+ * one are kept in memory until the comparison ends. There must be at least one file.
+ *
+ * @param reference Pointer to the line-reader of the reference-file
+ * @param lineReaders Array of the line-readers of the compared files
+ * @param fileNames Array of the filenames/paths of the compared files (for the file-headers)
+ * @param fileCount Amount of compared files
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param kernel The kernel which counts the differing characters per line
+ * @param threadCount Maximal amount of threads (including the calling thread), which compare the files
+ * @return The amount of different lines of all files or -1 if an error occured (errno is set)
+ */
+int64_t compareFilesMulti(struct lineReader *reference, struct lineReader **lineReaders, char **fileNames, size_t fileCount, struct outputSink *outputSink, diffKernel kernel, int threadCount);
+
+#endif
@@ -14,8 +14,51 @@
  * outputted instead.
  * The programms takes two arguments for files and the following options:
  * [-i] this option makes the comparison of the letter case insensitive
+ * [-j threads], with this option the comparison of two regular files is split
+ * into chunks, which are compared by the specified amount of threads.
  * [-o outputFile], with this option the user can specify the outputFile,
  * where the result should be written to.
+ * [-F format], with this option the format of the output can be specified:
+ * text (default), json (one object per differing line) or bin (two unsigned
+ * 64-bit little-endian integers per differing line: line and characters).
+ * [-x], with this option the first file is treated as baseline, whose line-index
+ * (offset, length and hash of every line) is stored in a sidecar-file. Lines of
+ * the second file with the same length and 64-bit hash are skipped without reading the
+ * first file, so only the second file is read. Two different lines of the same length
+ * are only taken as identical, if their hashes collide (probability about 2^-64 per line).
+ * [--lines first:last], with this option only the lines first to last (inclusive,
+ * starting with 1) are compared. If both files are regular files, the lines are
+ * found with the line-indexes of both files, which are built (in parallel) and
+ * saved once and reused as long as the files are unchanged.
+ * [-r reference], with this option any amount of files is compared with the reference-file,
+ * which is read only once. The report of every file starts with a file-header and the files
+ * are distributed over the threads specified with -j. This option can't be combined with
+ * -x or --lines. The report of the first file is written at once, the reports of the other
+ * files are kept in memory until the end, so put the file with the most differences first.
+ * If both files are directories, all regular files with the same relative path in both
+ * directory-trees are compared by a pool of threads (-j, one per processor by default).
+ * The reports start with a file-header and are written in the order of the paths. A pair, which
+ * can't be compared, gets an error instead of its report and the programm exits with EXIT_FAILURE.
+ * [-q], with this option nothing is printed and the comparison stops at the first differing
+ * line. The programm exits with code EXIT_FAILURE if the files differ.
+ * [-c], with this option only the amount of different lines and characters is printed.
+ * If both files are regular files, identical blocks are skipped with memcmp for -q and -c.
+ * [--follow[=statefile]], with this option the programm doesn't terminate after the comparison,
+ * but compares the lines which are appended to both files (e.g. replicated logs) until SIGINT
+ * or SIGTERM. Only the new complete lines are read. The offsets and the line number are kept in
+ * memory or in the specified state-file, so that the next run continues where this one stopped
+ * (unless a file was replaced or its start was rewritten, then both files are compared again).
+ * Both files have to be regular files (not stdin or a pipe) and -j can't be used.
+ * [-a], with this option the lines of both files are aligned (Myers' O(ND) algorithm in linear
+ * space) instead of compared at the same position, so an inserted line doesn't shift all
+ * following lines. Changed lines are printed with both line numbers and their edit distance,
+ * deleted and inserted lines with their length (Line: N1/N2, characters: M, - for a missing line).
+ * [-s], with this option statistics are printed to stderr after the comparison: the read lines and
+ * bytes (with --lines or -x only the compared part of mapped files), the different lines and characters, the throughput in bytes/s and lines/s and a histogram
+ * of the different characters per line (in buckets of powers of two). This option can't be combined
+ * with -q, -c, -r, --follow or directories.
+ * An input-file named - is read from stdin. Pipes and other files, which can't be mapped, are
+ * read ahead by a separate thread per file, so the comparison overlaps with the reading.
  */
 
 #include <stdio.h>
@@ -24,12 +67,62 @@
 #include <string.h>
 #include <strings.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <time.h>
 #include <unistd.h>
+#include "alignDiff.h"
+#include "diffKernel.h"
+#include "followDiff.h"
+#include "lineDiff.h"
+#include "lineIndex.h"
+#include "lineReader.h"
+#include "multiDiff.h"
+#include "outputSink.h"
+#include "parallelDiff.h"
+#include "summaryDiff.h"
+#include "treeDiff.h"
 
 #define NUMBER_OF_FILES 2 /** number of files that should be provided */
 
 static char *progName; /** name of the programm */
 
+static volatile sig_atomic_t isStopped = 0; /** flag which stops following the files */
+
+/**
+ * @brief Data structure to store the arguments and options of the programm
+ * @details The filename of the output is NULL if it isn't specified. A threadCount
+ * of 0 means that it isn't specified and 1 that the files are compared without additional
+ * threads. The line-range is inclusive and starts with line 1. If a reference-file is specified,
+ * all files in fileNamesInput are compared with it and the two input-files are not used.
+ */
+struct options
+{
+    char *fileNameInput1;
+    char *fileNameInput2;
+    char *fileNameOutput;
+    char *fileNameReference;
+    char *fileNameState;
+    char **fileNamesInput;
+    size_t fileCount;
+    bool isCaseInsensitive;
+    bool useIndex;
+    bool hasLineRange;
+    bool isQuiet;
+    bool isCountOnly;
+    bool isFollowing;
+    bool isAligned;
+    bool isStatistics;
+    enum outputFormat format;
+    int threadCount;
+    uint64_t firstLine;
+    uint64_t lastLine;
+};
+
 /**
  * @brief This function parses arguments
  * @details The function parses the options and arguments and saves them in the provided pointers. If the user
@@ -38,41 +131,99 @@ static char *progName; /** name of the programm */
  *
  * @param argumentCount Number of arguments provided
  * @param arguments Values of arguments provided
- * @param fileNameInput1 pointer to the string containing the filename/path for the first inputfile
- * @param fileNameInput2 pointer to the string containing the filename/path for the second inputfile
- * @param fileNameOutput pointer to the string containing the filename/path for the outputfile, if not specified it will be NULL
- * @param isCaseInsensitive pointer to a bool value which decides if the option case insensitive is used or not
+ * @param options pointer to the options, where the filenames and the specified options are saved to
  */
-static void parseArguments(int argumentCount, char **arguments, char **fileNameInput1, char **fileNameInput2, char **fileNameOutput, bool *isCaseInsensitive);
+static void parseArguments(int argumentCount, char **arguments, struct options *options);
 
 /**
  * @brief Opens the specified files.
  * @details If an error occurs when opening/creating the files it exits with code EXIT_FAILURE. If no
- * output file is specified it will be set to stdout.
+ * output file is specified it will be set to stdout. The input-files are opened as file descriptors,
+ * because they are mapped or read in blocks by the line-reader and not through stdio. An input-file
+ * named - is stdin.
  *
  * @param fileNameInput1 Pointer to the filename/path for the first input-file
  * @param fileNameInput2 Pointer to the filename/path for the second input-file
  * @param fileNameOutput Pointer to the filename/path for the output-file
- * @param fileInput1 Pointer to a file, which is used to store the content of the first input-file.
- * @param fileInput2 Pointer to a file, which is used to store the content of the second input-file.
+ * @param fileInput1 Pointer to a file descriptor, which is used to store the first input-file.
+ * @param fileInput2 Pointer to a file descriptor, which is used to store the second input-file.
  * @param fileOutput Pointer to a file, which is used to store the content of the output
  */
-static void openFiles(char *fileNameInput1, char *fileNameInput2, char *fileNameOutput, FILE **fileInput1, FILE **fileInput2, FILE **fileOutput);
+static void openFiles(char *fileNameInput1, char *fileNameInput2, char *fileNameOutput, int *fileInput1, int *fileInput2, FILE **fileOutput);
 
 /**
  * @brief This functions compares the specified files line by line and either prints it to stdout
- * or writes it to the specified file. This function reads character for character in each file
- * until both files reach a linebreak-symbol. If this happens a counter which counts the differences
- * per line will be evaluated. If one file reaches EOF the evaluation will be terminated and existing
- * differences will be printed. If the files are the same a specified messages will be printed at the end.
- * @details The caller should pass valid file-pointers otherwise the programm will not work properly.
+ * or writes it to the specified file. This function maps or reads both files in large blocks and compares
+ * each pair of lines up to the length of the shorter line with the selected diff-kernel. If one file
+ * reaches EOF the evaluation will be terminated and existing differences will be printed. If the files
+ * are the same a specified messages will be printed at the end.
+ * @details The caller should pass valid file-descriptors and file-pointers otherwise the programm will
+ * not work properly. Exits with code EXIT_FAILURE if reading one of the files fails.
+ * If the line-index should be used and the first file is mapped, the lines are compared with the
+ * help of the line-index. If a line-range is specified and both files are mapped, only the lines of
+ * the range are compared with the help of the line-indexes of both files. Otherwise, if more than
+ * one thread is specified and both files are mapped, the comparison is done in parallel.
+ * If only the differences should be counted (-q or -c), no line is printed. If the lines should be
+ * aligned, both files are read completely and aligned before the differences are printed.
+ *
+ * @param fileInput1 File descriptor of the first input-file
+ * @param fileInput2 File descriptor of the second input-file
+ * @param fileOutput Pointer to the stream specified for the output.
+ * @param options Pointer to the options, which decide how the files are compared.
+ * @return true if the files differ, otherwise false
+ */
+static bool compareFiles(int fileInput1, int fileInput2, FILE *fileOutput, const struct options *options);
+
+/**
+ * @brief This function opens the reference-file and all specified files and compares every file
+ * line by line with the reference-file, which is read only once. The reports of the files are
+ * written in the order of the files to stdout or the specified output-file.
+ * @details Exits with code EXIT_FAILURE if opening or reading one of the files fails.
+ *
+ * @param options Pointer to the options, which contain the filenames and decide how the files are compared.
+ */
+static void compareWithReference(const struct options *options);
+
+/**
+ * @brief Returns true, if the path is a directory (or a symbolic link to a directory)
+ *
+ * @param path The path which should be checked
+ * @return true if the path is a directory, otherwise false
+ */
+static bool isDirectory(const char *path);
+
+/**
+ * @brief Returns true, if the path is a regular file (or a symbolic link to a regular file).
+ * The filename - (stdin) is never a regular file.
+ *
+ * @param path The path which should be checked
+ * @return true if the path is a regular file, otherwise false
+ */
+static bool isRegularFile(const char *path);
+
+/**
+ * @brief This function compares all pairs of regular files with the same relative path in both
+ * directories and writes their reports in the order of the paths to stdout or the specified output-file.
+ * @details Exits with code EXIT_FAILURE if the first directory can't be read or writing the output fails.
+ * A pair, which can't be compared, gets its error in the output and the comparison continues, but
+ * afterwards the program exits with code EXIT_FAILURE too.
+ *
+ * @param options Pointer to the options, which contain the directories and decide how the files are compared.
+ */
+static void compareDirectories(const struct options *options);
+
+/**
+ * @brief This function compares the appended lines of both files over and over until SIGINT or SIGTERM
+ * is received and writes the differing lines to stdout or the specified output-file.
+ * @details Exits with code EXIT_FAILURE if reading one of the files or saving the state-file fails.
+ * global variables: isStopped
  *
- * @param fileInput1 Pointer to the input stream of the first input-file
- * @param fileInput2 Pointer to the input stream of the second input-file
+ * @param fileInput1 File descriptor of the first input-file
+ * @param fileInput2 File descriptor of the second input-file
  * @param fileOutput Pointer to the stream specified for the output.
- * @param isCaseInsensitive Flag if the comparison should be case insensitive.
+ * @param options Pointer to the options, which contain the filenames and the state-file.
  */
-static void compareFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput, bool isCaseInsensitive);
+static void followFileChanges(int fileInput1, int fileInput2, FILE *fileOutput, const struct options *options);
 
 /**
  * @brief This functions closes all files and reports possible errors back to the user without
@@ -80,11 +231,11 @@ static void compareFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput, b
  * @details The file-pointer should not be used after the call returned, because unexpected
  * behaviour will happen.
  *
- * @param fileInput1 Pointer to the input stream of the first input-file
- * @param fileInput2 Pointer to the input stream of the second input-file
+ * @param fileInput1 File descriptor of the first input-file
+ * @param fileInput2 File descriptor of the second input-file
  * @param fileOutput Pointer to the stream specified for the output.
  */
-static void closeFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput);
+static void closeFiles(int fileInput1, int fileInput2, FILE *fileOutput);
 
 /**
  * @brief The entry point of this programm, where all the different functions are called
@@ -98,24 +249,43 @@ static void closeFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput);
 
 int main(int argc, char *argv[])
 {
-    bool isCaseInsensitive = false;
-    char *fileNameOutput = NULL, *fileNameInput1 = NULL, *fileNameInput2 = NULL;
+    struct options options = {.format = FORMAT_TEXT, .threadCount = 0, .firstLine = 1, .lastLine = UINT64_MAX};
 
     // parseArguments
     progName = argv[0];
-    parseArguments(argc, argv, &fileNameInput1, &fileNameInput2, &fileNameOutput, &isCaseInsensitive);
+    parseArguments(argc, argv, &options);
+
+    if (options.fileNameReference != NULL)
+    {
+        compareWithReference(&options);
+        return EXIT_SUCCESS;
+    }
+
+    if (isDirectory(options.fileNameInput1) == true && isDirectory(options.fileNameInput2) == true)
+    {
+        compareDirectories(&options);
+        return EXIT_SUCCESS;
+    }
 
     // openFiles
-    FILE *fileInput1 = NULL, *fileInput2 = NULL, *fileOutput = NULL;
-    openFiles(fileNameInput1, fileNameInput2, fileNameOutput, &fileInput1, &fileInput2, &fileOutput);
+    int fileInput1 = -1, fileInput2 = -1;
+    FILE *fileOutput = NULL;
+    openFiles(options.fileNameInput1, options.fileNameInput2, options.fileNameOutput, &fileInput1, &fileInput2, &fileOutput);
+
+    if (options.isFollowing == true)
+    {
+        followFileChanges(fileInput1, fileInput2, fileOutput, &options);
+        closeFiles(fileInput1, fileInput2, fileOutput);
+        return EXIT_SUCCESS;
+    }
 
     // compareFiles
-    compareFiles(fileInput1, fileInput2, fileOutput, isCaseInsensitive);
+    bool isDifferent = compareFiles(fileInput1, fileInput2, fileOutput, &options);
 
     // close Files
     closeFiles(fileInput1, fileInput2, fileOutput);
 
-    return EXIT_SUCCESS;
+    return (options.isQuiet == true && isDifferent == true) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 /**
@@ -124,7 +294,9 @@ int main(int argc, char *argv[])
  */
 static void printUsageInfoAndExit(void)
 {
-    fprintf(stderr, "Usage: %s [-i] [-o outfile] file1 file2\n", progName);
+    fprintf(stderr, "Usage: %s [-i] [-a | -q | -c] [-s] [-j threads] [-o outfile] [-F text|json|bin] [-x] [--lines first:last] [--follow[=statefile]] file1 file2\n"
+                    "       %s [-i] [-j threads] [-o outfile] [-F text|json|bin] -r reference file1...\n",
+            progName, progName);
     exit(EXIT_FAILURE);
 }
 
@@ -140,19 +312,117 @@ static void printErrorAndExit(char *errorMessage)
     exit(EXIT_FAILURE);
 }
 
-static void parseArguments(int argumentCount, char **arguments, char **fileNameInput1, char **fileNameInput2, char **fileNameOutput, bool *isCaseInsensitive)
+/**
+ * @brief This function parses a positive number of an option. If the value is not a positive
+ * number the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @return The parsed number
+ */
+static int parsePositiveNumber(char *value)
+{
+    char *end;
+    errno = 0;
+    long number = strtol(value, &end, 10);
+
+    if (errno != 0 || end == value || *end != '\0' || number < 1 || number > INT_MAX)
+        printUsageInfoAndExit();
+
+    return number;
+}
+
+/**
+ * @brief This function parses the line-range of the option --lines (format first:last). If the
+ * range is invalid the usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @param options Pointer to the options, where the line-range is saved to
+ */
+static void parseLineRange(char *value, struct options *options)
+{
+    char *end;
+    errno = 0;
+    options->firstLine = strtoull(value, &end, 10);
+    if (errno != 0 || end == value || *end != ':' || options->firstLine < 1 || value[0] == '-')
+        printUsageInfoAndExit();
+
+    char *last = end + 1;
+    options->lastLine = strtoull(last, &end, 10);
+    if (errno != 0 || end == last || *end != '\0' || options->lastLine < options->firstLine || last[0] == '-')
+        printUsageInfoAndExit();
+
+    options->hasLineRange = true;
+}
+
+/**
+ * @brief This function parses the format of the output. If the format is unknown the
+ * usage-Message is printed and the programm exits with code EXIT_FAILURE.
+ *
+ * @param value The value of the option
+ * @return The parsed format
+ */
+static enum outputFormat parseOutputFormat(char *value)
+{
+    if (strcmp(value, "text") == 0)
+        return FORMAT_TEXT;
+    if (strcmp(value, "json") == 0)
+        return FORMAT_JSON;
+    if (strcmp(value, "bin") == 0)
+        return FORMAT_BINARY;
+
+    printUsageInfoAndExit();
+    return FORMAT_TEXT;
+}
+
+static void parseArguments(int argumentCount, char **arguments, struct options *options)
 {
+    static struct option longOptions[] = {
+        {"lines", required_argument, NULL, 'l'},
+        {"follow", optional_argument, NULL, 'f'},
+        {NULL, 0, NULL, 0}};
+
     // parse Arguments
     int opt;
-    while ((opt = getopt(argumentCount, arguments, "io:")) != -1)
+    while ((opt = getopt_long(argumentCount, arguments, "ij:o:F:xr:qcas", longOptions, NULL)) != -1)
     {
         switch (opt)
         {
         case 'i':
-            *isCaseInsensitive = true;
+            options->isCaseInsensitive = true;
+            break;
+        case 'j':
+            options->threadCount = parsePositiveNumber(optarg);
             break;
         case 'o':
-            *fileNameOutput = optarg;
+            options->fileNameOutput = optarg;
+            break;
+        case 'F':
+            options->format = parseOutputFormat(optarg);
+            break;
+        case 'x':
+            options->useIndex = true;
+            break;
+        case 'l':
+            parseLineRange(optarg, options);
+            break;
+        case 'r':
+            options->fileNameReference = optarg;
+            break;
+        case 'q':
+            options->isQuiet = true;
+            break;
+        case 'a':
+            options->isAligned = true;
+            break;
+        case 'f':
+            options->isFollowing = true;
+            options->fileNameState = optarg;
+            break;
+        case 'c':
+            options->isCountOnly = true;
+            break;
+        case 's':
+            options->isStatistics = true;
             break;
         case '?':
             printUsageInfoAndExit();
@@ -162,103 +432,584 @@ static void parseArguments(int argumentCount, char **arguments, char **fileNameI
         }
     }
 
+    // the differences are only counted for a simple comparison of two files
+    if ((options->isQuiet == true || options->isCountOnly == true) &&
+        ((options->isQuiet == true && options->isCountOnly == true) || options->useIndex == true || options->hasLineRange == true || options->fileNameReference != NULL))
+        printUsageInfoAndExit();
+
+    // the lines can only be aligned in a simple comparison of two files
+    if (options->isAligned == true &&
+        (options->isQuiet == true || options->isCountOnly == true || options->useIndex == true || options->hasLineRange == true || options->fileNameReference != NULL || options->isFollowing == true))
+        printUsageInfoAndExit();
+
+    // the statistics need the records of the differing lines of two files
+    if (options->isStatistics == true &&
+        (options->isQuiet == true || options->isCountOnly == true || options->fileNameReference != NULL || options->isFollowing == true))
+        printUsageInfoAndExit();
+
+    // following the files only works with a simple comparison of two files, which is done by one thread
+    if (options->isFollowing == true &&
+        (options->isQuiet == true || options->isCountOnly == true || options->useIndex == true || options->hasLineRange == true || options->fileNameReference != NULL || options->threadCount > 0))
+        printUsageInfoAndExit();
+
+    // check if at least one filename is specified to compare with the reference-file
+    if (options->fileNameReference != NULL)
+    {
+        if (optind >= argumentCount || options->useIndex == true || options->hasLineRange == true)
+            printUsageInfoAndExit();
+
+        options->fileNamesInput = &arguments[optind];
+        options->fileCount = argumentCount - optind;
+
+        // stdin can only be read as one of the files
+        size_t stdinCount = (strcmp(options->fileNameReference, "-") == 0) ? 1 : 0;
+        for (size_t i = 0; i < options->fileCount; i++)
+            stdinCount += (strcmp(options->fileNamesInput[i], "-") == 0) ? 1 : 0;
+        if (stdinCount > 1)
+            printUsageInfoAndExit();
+        return;
+    }
+
     // check if the two filenames are specified
     if (optind + NUMBER_OF_FILES != argumentCount)
         printUsageInfoAndExit();
 
     // save the filenames
-    *fileNameInput1 = arguments[optind];
-    *fileNameInput2 = arguments[optind + 1];
+    options->fileNameInput1 = arguments[optind];
+    options->fileNameInput2 = arguments[optind + 1];
+
+    // stdin can only be read as one of the files
+    if (strcmp(options->fileNameInput1, "-") == 0 && strcmp(options->fileNameInput2, "-") == 0)
+        printUsageInfoAndExit();
+
+    // the statistics are only printed for two files
+    if (options->isStatistics == true && isDirectory(options->fileNameInput1) == true && isDirectory(options->fileNameInput2) == true)
+        printUsageInfoAndExit();
+
+    // only regular files grow by appended lines, stdin and pipes report no size to follow
+    if (options->isFollowing == true && (isRegularFile(options->fileNameInput1) == false || isRegularFile(options->fileNameInput2) == false))
+        printUsageInfoAndExit();
 }
 
-static void openFiles(char *fileNameInput1, char *fileNameInput2, char *fileNameOutput, FILE **fileInput1, FILE **fileInput2, FILE **fileOutput)
+static bool isDirectory(const char *path)
 {
-    if ((*fileInput1 = fopen(fileNameInput1, "r")) == NULL)
+    struct stat status;
+    return stat(path, &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+static bool isRegularFile(const char *path)
+{
+    struct stat status;
+    return strcmp(path, "-") != 0 && stat(path, &status) == 0 && S_ISREG(status.st_mode);
+}
+
+/**
+ * @brief Opens the specified input-file for reading. The filename - stands for stdin.
+ *
+ * @param fileNameInput Pointer to the filename/path of the input-file
+ * @return File descriptor of the input-file or -1 if opening failed
+ */
+static int openInputFile(const char *fileNameInput)
+{
+    if (strcmp(fileNameInput, "-") == 0)
+        return STDIN_FILENO;
+
+    return open(fileNameInput, O_RDONLY);
+}
+
+/**
+ * @brief Opens or creates the specified output-file. If no output-file is specified stdout is returned.
+ * @details Exits with code EXIT_FAILURE if opening/creating the file fails.
+ *
+ * @param fileNameOutput Pointer to the filename/path for the output-file or NULL
+ * @return Pointer to the stream for the output
+ */
+static FILE *openOutputFile(char *fileNameOutput)
+{
+    if (fileNameOutput == NULL)
+        return stdout;
+
+    FILE *fileOutput = fopen(fileNameOutput, "w");
+    if (fileOutput == NULL)
+    {
+        printErrorAndExit("Openening or creating output-file failed\n");
+    }
+
+    return fileOutput;
+}
+
+static void openFiles(char *fileNameInput1, char *fileNameInput2, char *fileNameOutput, int *fileInput1, int *fileInput2, FILE **fileOutput)
+{
+    if ((*fileInput1 = openInputFile(fileNameInput1)) == -1)
     {
         printErrorAndExit("Opening input-file 1 failed\n");
     }
 
-    if ((*fileInput2 = fopen(fileNameInput2, "r")) == NULL)
+    if ((*fileInput2 = openInputFile(fileNameInput2)) == -1)
     {
         printErrorAndExit("Opening input-file 2 failed\n");
     }
 
-    if (fileNameOutput != NULL)
+    *fileOutput = openOutputFile(fileNameOutput);
+}
+
+/**
+ * @brief Compares the lines of both line-readers one after another and prints the differing lines.
+ * Lines outside of the line-range are read, but not compared.
+ * @details Exits with code EXIT_FAILURE if reading one of the files or writing the output fails.
+ *
+ * @param lineReader1 Pointer to the line-reader of the first input-file
+ * @param lineReader2 Pointer to the line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output.
+ * @param kernel The kernel which counts the differing characters per line
+ * @param options Pointer to the options, which contain the line-range
+ * @return The amount of different lines
+ */
+static int64_t compareLines(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, const struct options *options)
+{
+    struct lineReport report = {outputSink, outputSink->format, 0};
+    if (compareLineReaders(lineReader1, lineReader2, kernel, 1, options->firstLine, options->lastLine, &report) == -1)
+        printErrorAndExit("Comparing the files failed");
+
+    return report.differentLines;
+}
+
+/**
+ * @brief Returns the amount of threads, which should build a line-index or compare directory-trees.
+ * If no amount of threads is specified, one thread per online processor is used.
+ *
+ * @param options Pointer to the options, which contain the amount of threads
+ * @return The amount of threads (at least 1)
+ */
+static int getThreadCount(const struct options *options)
+{
+    if (options->threadCount > 0)
+        return options->threadCount;
+
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+    return (processorCount > 0 && processorCount <= INT_MAX) ? processorCount : 1;
+}
+
+/**
+ * @brief Returns the line-index of the mapped file. If no valid sidecar-file exists, the line-index
+ * is built with the specified amount of threads and saved for the next run.
+ * @details Exits with code EXIT_FAILURE if the line-index can't be built. Failing to save the
+ * line-index only prints a warning, because the comparison works without the sidecar-file.
+ *
+ * @param lineReader Pointer to the mapped line-reader of the file
+ * @param fileName The filename/path of the file
+ * @param threadCount Amount of threads, which build the line-index
+ * @return Pointer to the line-index, which has to be closed by the caller
+ */
+static struct lineIndex *getLineIndex(struct lineReader *lineReader, char *fileName, int threadCount)
+{
+    struct lineIndex *lineIndex = loadLineIndex(fileName, lineReader->fd);
+    if (lineIndex == NULL)
+    {
+        lineIndex = buildLineIndex(lineReader->fd, lineReader->buffer, lineReader->end, threadCount);
+        if (lineIndex == NULL)
+            printErrorAndExit("Building the line-index failed");
+
+        if (saveLineIndex(lineIndex, fileName) == -1)
+            fprintf(stderr, "[%s] WARNING: Saving the line-index failed: %s\n", progName, strerror(errno));
+    }
+
+    return lineIndex;
+}
+
+/**
+ * @brief Exits with code EXIT_FAILURE, because an entry of the line-index lies outside of the file
+ * @details global variables: progName
+ *
+ * @param fileName The filename/path of the indexed file
+ */
+static void printDamagedIndexAndExit(const char *fileName)
+{
+    fprintf(stderr, "[%s] ERROR: The line-index of %s is damaged, remove %s%s\n", progName, fileName, fileName, INDEX_SUFFIX);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Compares the lines of the second file with the lines of the mapped first file with the
+ * help of the line-index of the first file. A line with the same length and hash as the line in
+ * the first file is skipped without reading the first file (the hash isn't confirmed byte by byte,
+ * that would read both files again), all other lines are compared up to the end of the shorter line.
+ * Lines outside of the line-range are read, but not compared.
+ * @details If no valid sidecar-file exists, the line-index is built and saved for the next run.
+ * Exits with code EXIT_FAILURE if the line-index can't be built, is damaged or reading the second
+ * file fails.
+ *
+ * @param lineReader1 Pointer to the mapped line-reader of the first input-file
+ * @param lineReader2 Pointer to the line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output.
+ * @param kernel The kernel which counts the differing characters per line
+ * @param options Pointer to the options, which contain the filename and the line-range
+ * @param readLines Pointer which will be set to the amount of lines read from both files
+ * @param readBytes Pointer which will be set to the amount of bytes read from both files
+ * @return The amount of different lines
+ */
+static int64_t compareLinesIndexed(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, const struct options *options, uint64_t *readLines, uint64_t *readBytes)
+{
+    struct lineIndex *lineIndex = getLineIndex(lineReader1, options->fileNameInput1, getThreadCount(options));
+    uint64_t lineCount = (lineIndex->header->lineCount < options->lastLine) ? lineIndex->header->lineCount : options->lastLine;
+
+    const char *line2;
+    size_t length2;
+    size_t differencePerLine = 0;
+    int64_t differentLines = 0;
+    uint64_t lineIdx = 1;
+    uint64_t i = 0;
+    int status = 0;
+
+    for (; i < lineCount && (status = readLine(lineReader2, &line2, &length2)) == 1; i++)
     {
-        if ((*fileOutput = fopen(fileNameOutput, "w")) == NULL)
+        const struct lineIndexEntry *entry = &lineIndex->entries[i];
+
+        // skip the line, if it is outside of the range or identical to the line of the first file
+        if (i + 1 >= options->firstLine && (entry->length != length2 || entry->hash != hashLine(line2, length2)))
         {
-            printErrorAndExit("Openening or creating output-file failed\n");
+            const char *line1 = getIndexedLine(lineIndex, entry, lineReader1->buffer);
+            if (line1 == NULL)
+                printDamagedIndexAndExit(options->fileNameInput1);
+
+            differencePerLine = kernel(line1, line2, (entry->length < length2) ? entry->length : length2);
+            if (differencePerLine > 0)
+            {
+                if (writeDifference(outputSink, lineIdx, differencePerLine) == -1)
+                    printErrorAndExit("Writing the output failed");
+                differentLines++;
+            }
         }
+
+        lineIdx++;
     }
-    else
+
+    // the first i lines of both files are read, the rest of the mapped first file isn't
+    *readLines = 2 * i;
+    *readBytes = countIndexedBytes(lineIndex, 1, i) + countConsumedBytes(lineReader2);
+
+    closeLineIndex(lineIndex);
+
+    if (status == -1)
+        printErrorAndExit("Reading an input-file failed");
+
+    return differentLines;
+}
+
+/**
+ * @brief Compares only the lines of the line-range of both mapped files. The first line of the
+ * range is found directly with the line-indexes of both files, so that no line before the range
+ * has to be read. Lines with the same length and hash are skipped without reading them (like -x).
+ * @details The lines are only read through getIndexedLine, which checks the entries of loaded
+ * line-indexes against the files. Exits with code EXIT_FAILURE if a line-index can't be built or
+ * is damaged.
+ *
+ * @param lineReader1 Pointer to the mapped line-reader of the first input-file
+ * @param lineReader2 Pointer to the mapped line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output.
+ * @param kernel The kernel which counts the differing characters per line
+ * @param options Pointer to the options, which contain the filenames and the line-range
+ * @param readLines Pointer which will be set to the amount of lines of the range of both files
+ * @param readBytes Pointer which will be set to the amount of bytes of the range of both files
+ * @return The amount of different lines
+ */
+static int64_t compareLineRange(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, const struct options *options, uint64_t *readLines, uint64_t *readBytes)
+{
+    int threadCount = getThreadCount(options);
+    struct lineIndex *lineIndex1 = getLineIndex(lineReader1, options->fileNameInput1, threadCount);
+    struct lineIndex *lineIndex2 = getLineIndex(lineReader2, options->fileNameInput2, threadCount);
+
+    uint64_t lastLine = options->lastLine;
+    if (lastLine > lineIndex1->header->lineCount)
+        lastLine = lineIndex1->header->lineCount;
+    if (lastLine > lineIndex2->header->lineCount)
+        lastLine = lineIndex2->header->lineCount;
+
+    // only the range counts as read, the lines before and after it aren't touched
+    *readLines = (lastLine >= options->firstLine) ? 2 * (lastLine - options->firstLine + 1) : 0;
+    *readBytes = countIndexedBytes(lineIndex1, options->firstLine, lastLine) + countIndexedBytes(lineIndex2, options->firstLine, lastLine);
+
+    size_t differencePerLine = 0;
+    int64_t differentLines = 0;
+    for (uint64_t lineIdx = options->firstLine; lineIdx <= lastLine; lineIdx++)
     {
-        *fileOutput = stdout;
+        const struct lineIndexEntry *entry1 = &lineIndex1->entries[lineIdx - 1];
+        const struct lineIndexEntry *entry2 = &lineIndex2->entries[lineIdx - 1];
+        if (entry1->length == entry2->length && entry1->hash == entry2->hash)
+            continue;
+
+        const char *line1 = getIndexedLine(lineIndex1, entry1, lineReader1->buffer);
+        const char *line2 = getIndexedLine(lineIndex2, entry2, lineReader2->buffer);
+        if (line1 == NULL)
+            printDamagedIndexAndExit(options->fileNameInput1);
+        if (line2 == NULL)
+            printDamagedIndexAndExit(options->fileNameInput2);
+
+        uint64_t length = (entry1->length < entry2->length) ? entry1->length : entry2->length;
+        differencePerLine = kernel(line1, line2, length);
+        if (differencePerLine > 0)
+        {
+            if (writeDifference(outputSink, lineIdx, differencePerLine) == -1)
+                printErrorAndExit("Writing the output failed");
+            differentLines++;
+        }
     }
+
+    closeLineIndex(lineIndex1);
+    closeLineIndex(lineIndex2);
+
+    return differentLines;
 }
 
 /**
- * @brief A functions which checks if a character is either linebreak or EOF-Symbol
+ * @brief Counts the different lines and characters without printing the lines. With the option -c the
+ * totals are printed, with the option -q nothing is printed and the comparison stops at the first
+ * differing line.
+ * @details Exits with code EXIT_FAILURE if reading one of the files fails.
  *
- * @param c The character to check
- * @return true, if the specifed character is a linebreak or EOF-Symbol
- * @return false, if the specified character is neither a linebreak or EOF-Symbol
+ * @param lineReader1 Pointer to the line-reader of the first input-file
+ * @param lineReader2 Pointer to the line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output.
+ * @param kernel The kernel which counts the differing characters per line
+ * @param options Pointer to the options, which contain -q and -c
+ * @return true if the files differ, otherwise false
  */
-static bool isEOForLinebreak(char c)
+static bool summarizeLines(struct lineReader *lineReader1, struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, const struct options *options)
 {
-    return c == EOF || c == '\n';
+    struct diffSummary summary;
+    if (summarizeFiles(lineReader1, lineReader2, kernel, options->isQuiet, &summary) == -1)
+        printErrorAndExit("Reading an input-file failed");
+
+    if (options->isCountOnly == true && writeTotals(outputSink, summary.differentLines, summary.differentCharacters) == -1)
+        printErrorAndExit("Writing the output failed");
+
+    return summary.differentLines > 0;
 }
 
-static void compareFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput, bool isCaseInsensitive)
+/**
+ * @brief Prints the statistics of the comparison to stderr.
+ * @details Exits with code EXIT_FAILURE if printing fails.
+ *
+ * @param outputSink Pointer to the output-sink, which counted the differences
+ * @param readLines Amount of lines, which were read from both input-files
+ * @param readBytes Amount of bytes, which were read from both input-files
+ * @param startTime Pointer to the time (CLOCK_MONOTONIC), at which the comparison started
+ */
+static void printComparisonStatistics(const struct outputSink *outputSink, uint64_t readLines, uint64_t readBytes, const struct timespec *startTime)
 {
-    int (*cmpFunction)(const char *s1, const char *s2, size_t n) = isCaseInsensitive ? &strncasecmp : &strncmp;
+    struct timespec endTime;
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+    double seconds = (endTime.tv_sec - startTime->tv_sec) + (endTime.tv_nsec - startTime->tv_nsec) / 1e9;
+
+    if (printStatistics(stderr, &outputSink->statistics, readLines, readBytes, seconds) == -1)
+        printErrorAndExit("Printing the statistics failed");
+}
 
-    char tempCharFile1 = 0, tempCharFile2 = 0;
-    int differencePerLine = 0, differentLines = 0, lineIdx = 1;
-    bool endOfLineOrEOFFile1 = false, endOfLineOrEOFFile2 = false;
+static bool compareFiles(int fileInput1, int fileInput2, FILE *fileOutput, const struct options *options)
+{
+    diffKernel kernel = selectDiffKernel(options->isCaseInsensitive);
 
-    while (tempCharFile1 != EOF && tempCharFile2 != EOF)
+    struct timespec startTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+    struct lineReader *lineReader1 = openLineReader(fileInput1);
+    struct lineReader *lineReader2 = openLineReader(fileInput2);
+    if (lineReader1 == NULL || lineReader2 == NULL)
+        printErrorAndExit("Allocation of the line-reader failed");
+
+    struct outputSink *outputSink = openOutputSink(fileOutput, options->format);
+    if (outputSink == NULL)
+        printErrorAndExit("Allocation of the output-sink failed");
+
+    // the line-range and the line-index read only a part of the mapped files, so they count it themselves
+    int64_t differentLines;
+    uint64_t readLines = 0, readBytes = 0;
+    bool isReadCounted = false;
+    if (options->isAligned == true)
+    {
+        differentLines = compareFilesAligned(lineReader1, lineReader2, outputSink, options->isCaseInsensitive);
+        if (differentLines == -1)
+            printErrorAndExit("Aligning the files failed");
+    }
+    else if (options->isQuiet == true || options->isCountOnly == true)
+    {
+        differentLines = (summarizeLines(lineReader1, lineReader2, outputSink, kernel, options) == true) ? 1 : 0;
+    }
+    else if (options->hasLineRange == true && lineReader1->isMapped == true && lineReader2->isMapped == true)
     {
-        if (endOfLineOrEOFFile1 == false)
-            tempCharFile1 = fgetc(fileInput1);
+        differentLines = compareLineRange(lineReader1, lineReader2, outputSink, kernel, options, &readLines, &readBytes);
+        isReadCounted = true;
+    }
+    else if (options->useIndex == true && lineReader1->isMapped == true)
+    {
+        differentLines = compareLinesIndexed(lineReader1, lineReader2, outputSink, kernel, options, &readLines, &readBytes);
+        isReadCounted = true;
+    }
+    else if (options->hasLineRange == false && options->threadCount > 1 && lineReader1->isMapped == true && lineReader2->isMapped == true)
+    {
+        differentLines = compareFilesParallel(lineReader1, lineReader2, outputSink, kernel, options->threadCount);
+        if (differentLines == -1)
+            printErrorAndExit("Comparing the files in parallel failed");
+    }
+    else
+    {
+        differentLines = compareLines(lineReader1, lineReader2, outputSink, kernel, options);
+    }
 
-        if (endOfLineOrEOFFile2 == false)
-            tempCharFile2 = fgetc(fileInput2);
+    bool isSummary = options->isQuiet == true || options->isCountOnly == true;
+    if (isSummary == false && differentLines == 0 && writeNoDifferences(outputSink) == -1)
+        printErrorAndExit("Writing the output failed");
 
-        endOfLineOrEOFFile1 = isEOForLinebreak(tempCharFile1);
-        endOfLineOrEOFFile2 = isEOForLinebreak(tempCharFile2);
+    if (flushOutputSink(outputSink) == -1)
+        printErrorAndExit("Writing the output failed");
 
-        if (endOfLineOrEOFFile1 == false && endOfLineOrEOFFile2 == false)
+    if (options->isStatistics == true)
+    {
+        if (isReadCounted == false)
         {
-            if (cmpFunction(&tempCharFile1, &tempCharFile2, 1) != 0)
-                differencePerLine++;
+            uint64_t lines1, bytes1, lines2, bytes2;
+            countReadInput(lineReader1, &lines1, &bytes1);
+            countReadInput(lineReader2, &lines2, &bytes2);
+            readLines = lines1 + lines2;
+            readBytes = bytes1 + bytes2;
         }
 
-        if (endOfLineOrEOFFile1 == true && endOfLineOrEOFFile2 == true)
-        {
-            if (differencePerLine > 0)
-            {
-                fprintf(fileOutput, "Line: %d, characters: %d\n", lineIdx, differencePerLine);
-                differentLines++;
-            }
+        printComparisonStatistics(outputSink, readLines, readBytes, &startTime);
+    }
 
-            lineIdx++;
-            differencePerLine = 0;
-            endOfLineOrEOFFile1 = endOfLineOrEOFFile2 = false;
-        }
+    closeLineReader(lineReader1);
+    closeLineReader(lineReader2);
+
+    closeOutputSink(outputSink);
+
+    return differentLines > 0;
+}
+
+static void compareWithReference(const struct options *options)
+{
+    int fileReference = openInputFile(options->fileNameReference);
+    if (fileReference == -1)
+        printErrorAndExit("Opening the reference-file failed");
+
+    int *filesInput = malloc(options->fileCount * sizeof(int));
+    struct lineReader **lineReaders = malloc(options->fileCount * sizeof(struct lineReader *));
+    if (filesInput == NULL || lineReaders == NULL)
+        printErrorAndExit("Allocation of the line-readers failed");
+
+    for (size_t i = 0; i < options->fileCount; i++)
+    {
+        if ((filesInput[i] = openInputFile(options->fileNamesInput[i])) == -1)
+            printErrorAndExit("Opening an input-file failed");
+
+        if ((lineReaders[i] = openLineReader(filesInput[i])) == NULL)
+            printErrorAndExit("Allocation of the line-reader failed");
     }
 
-    if (differentLines == 0)
-        fprintf(fileOutput, "No differences found!");
+    struct lineReader *lineReaderReference = openLineReader(fileReference);
+    if (lineReaderReference == NULL)
+        printErrorAndExit("Allocation of the line-reader failed");
+
+    FILE *fileOutput = openOutputFile(options->fileNameOutput);
+    struct outputSink *outputSink = openOutputSink(fileOutput, options->format);
+    if (outputSink == NULL)
+        printErrorAndExit("Allocation of the output-sink failed");
+
+    diffKernel kernel = selectDiffKernel(options->isCaseInsensitive);
+    int threadCount = (options->threadCount > 0) ? options->threadCount : 1;
+    if (compareFilesMulti(lineReaderReference, lineReaders, options->fileNamesInput, options->fileCount, outputSink, kernel, threadCount) == -1)
+        printErrorAndExit("Comparing the files with the reference-file failed");
+
+    if (flushOutputSink(outputSink) == -1)
+        printErrorAndExit("Writing the output failed");
+
+    closeOutputSink(outputSink);
+    closeLineReader(lineReaderReference);
+
+    if (close(fileReference) == -1)
+        fprintf(stderr, "[%s] ERROR: Closing the reference-file failed: %s\n", progName, strerror(errno));
+
+    for (size_t i = 0; i < options->fileCount; i++)
+    {
+        closeLineReader(lineReaders[i]);
+        if (close(filesInput[i]) == -1)
+            fprintf(stderr, "[%s] ERROR: Closing input-file %s failed: %s\n", progName, options->fileNamesInput[i], strerror(errno));
+    }
+
+    if (fclose(fileOutput) == EOF)
+        fprintf(stderr, "[%s] ERROR: Closing specified output failed: %s\n", progName, strerror(errno));
+
+    free(filesInput);
+    free(lineReaders);
+}
+
+static void compareDirectories(const struct options *options)
+{
+    if (options->useIndex == true || options->hasLineRange == true || options->isQuiet == true || options->isCountOnly == true || options->isFollowing == true || options->isAligned == true)
+        printUsageInfoAndExit();
+
+    FILE *fileOutput = openOutputFile(options->fileNameOutput);
+    struct outputSink *outputSink = openOutputSink(fileOutput, options->format);
+    if (outputSink == NULL)
+        printErrorAndExit("Allocation of the output-sink failed");
+
+    diffKernel kernel = selectDiffKernel(options->isCaseInsensitive);
+    uint64_t failedPairs = 0;
+    if (compareTrees(options->fileNameInput1, options->fileNameInput2, outputSink, kernel, getThreadCount(options), &failedPairs) == -1)
+        printErrorAndExit("Comparing the directories failed");
+
+    if (flushOutputSink(outputSink) == -1)
+        printErrorAndExit("Writing the output failed");
+
+    closeOutputSink(outputSink);
+
+    if (fclose(fileOutput) == EOF)
+        fprintf(stderr, "[%s] ERROR: Closing specified output failed: %s\n", progName, strerror(errno));
+
+    if (failedPairs > 0)
+    {
+        fprintf(stderr, "[%s] ERROR: %" PRIu64 " pairs couldn't be compared\n", progName, failedPairs);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Function which handles the SIGINT and SIGTERM signals and sets the variable isStopped to 1
+ * @details global variables: isStopped
+ *
+ * @param signal Signal-number (which will be not used)
+ */
+static void handleSignal(int signal)
+{
+    isStopped = 1;
+}
+
+static void followFileChanges(int fileInput1, int fileInput2, FILE *fileOutput, const struct options *options)
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handleSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    struct outputSink *outputSink = openOutputSink(fileOutput, options->format);
+    if (outputSink == NULL)
+        printErrorAndExit("Allocation of the output-sink failed");
+
+    diffKernel kernel = selectDiffKernel(options->isCaseInsensitive);
+    if (followFiles(options->fileNameInput1, fileInput1, options->fileNameInput2, fileInput2, options->fileNameState, outputSink, kernel, &isStopped) == -1)
+        printErrorAndExit("Following the files failed");
+
+    closeOutputSink(outputSink);
 }
 
-static void closeFiles(FILE *fileInput1, FILE *fileInput2, FILE *fileOutput)
+static void closeFiles(int fileInput1, int fileInput2, FILE *fileOutput)
 {
-    // no need to terminate because, if an error occures in fclose the stream gets closed
+    // no need to terminate because, if an error occures in close the file gets closed
     // but we want to handle the code and report it back to the user.
-    if (fclose(fileInput1) == EOF)
+    if (close(fileInput1) == -1)
         fprintf(stderr, "[%s] ERROR: Closing input-file 1 failed: %s\n", progName, strerror(errno));
 
-    if (fclose(fileInput2) == EOF)
+    if (close(fileInput2) == -1)
         fprintf(stderr, "[%s] ERROR: Closing input-file 2 failed: %s\n", progName, strerror(errno));
 
     if (fclose(fileOutput) == EOF)
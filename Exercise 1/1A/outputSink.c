@@ -0,0 +1,438 @@
+/**
+ * @file outputSink.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to open/close the output-sink
+ * and to write/flush the records.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "outputSink.h"
+
+/**
+ * @brief Maximal length of one formatted record (two 20-digit numbers and the text)
+ */
+#define MAX_RECORD_LENGTH 80
+
+/**
+ * @brief Initial capacity of an output-sink, which only collects the records in memory
+ */
+#define MEMORY_BUFFER_SIZE 4096
+
+/**
+ * @brief All two-digit numbers, so that two digits are formatted at once
+ */
+static const char digitPairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+struct outputSink *openOutputSink(FILE *file, enum outputFormat format)
+{
+    struct outputSink *outputSink = malloc(sizeof(struct outputSink));
+    if (outputSink == NULL)
+        return NULL;
+
+    outputSink->capacity = (file == NULL) ? MEMORY_BUFFER_SIZE : OUTPUT_BUFFER_SIZE;
+    outputSink->buffer = malloc(outputSink->capacity);
+    if (outputSink->buffer == NULL)
+    {
+        free(outputSink);
+        return NULL;
+    }
+
+    outputSink->file = file;
+    outputSink->format = format;
+    outputSink->length = 0;
+    outputSink->isLineOpen = false;
+    memset(&outputSink->statistics, 0, sizeof(struct diffStatistics));
+
+    return outputSink;
+}
+
+void closeOutputSink(struct outputSink *outputSink)
+{
+    free(outputSink->buffer);
+    free(outputSink);
+}
+
+/**
+ * @brief Writes the buffer to the file and empties it
+ *
+ * @param outputSink Pointer to the output-sink
+ * @return 0 on success and -1 on error
+ */
+static int writeBuffer(struct outputSink *outputSink)
+{
+    if (outputSink->length > 0 && fwrite(outputSink->buffer, 1, outputSink->length, outputSink->file) != outputSink->length)
+        return -1;
+
+    outputSink->length = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Ensures that the specified amount of bytes fits into the buffer. The buffer of
+ * an output-sink with a file is written, the buffer of an output-sink in memory is doubled.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param size Amount of bytes which should be written to the buffer
+ * @return 0 on success and -1 on error
+ */
+static int reserveBuffer(struct outputSink *outputSink, size_t size)
+{
+    if (outputSink->length + size <= outputSink->capacity)
+        return 0;
+
+    if (outputSink->file != NULL && size <= outputSink->capacity)
+        return writeBuffer(outputSink);
+
+    size_t capacity = outputSink->capacity;
+    while (outputSink->length + size > capacity)
+        capacity *= 2;
+
+    char *buffer = realloc(outputSink->buffer, capacity);
+    if (buffer == NULL)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    outputSink->buffer = buffer;
+    outputSink->capacity = capacity;
+
+    return 0;
+}
+
+/**
+ * @brief Appends the characters to the buffer, which has to have enough space
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param text The characters which should be appended
+ * @param length Amount of characters
+ */
+static void appendText(struct outputSink *outputSink, const char *text, size_t length)
+{
+    memcpy(outputSink->buffer + outputSink->length, text, length);
+    outputSink->length += length;
+}
+
+/**
+ * @brief Appends the decimal digits of the number to the buffer, which has to have enough space.
+ * @details The digits are formatted from the back, two digits per division.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param number The number which should be formatted
+ */
+static void appendNumber(struct outputSink *outputSink, uint64_t number)
+{
+    char digits[20];
+    size_t i = sizeof(digits);
+
+    while (number >= 100)
+    {
+        size_t pair = (number % 100) * 2;
+        number /= 100;
+        digits[--i] = digitPairs[pair + 1];
+        digits[--i] = digitPairs[pair];
+    }
+
+    if (number >= 10)
+    {
+        digits[--i] = digitPairs[number * 2 + 1];
+        digits[--i] = digitPairs[number * 2];
+    }
+    else
+    {
+        digits[--i] = '0' + number;
+    }
+
+    appendText(outputSink, digits + i, sizeof(digits) - i);
+}
+
+/**
+ * @brief Appends the number as 8 bytes in little-endian byte order to the buffer, which
+ * has to have enough space.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param number The number which should be appended
+ */
+static void appendBinary(struct outputSink *outputSink, uint64_t number)
+{
+    for (int i = 0; i < 8; i++)
+        outputSink->buffer[outputSink->length++] = (char)(number >> (i * 8));
+}
+
+int writeDifference(struct outputSink *outputSink, uint64_t line, uint64_t characters)
+{
+    if (reserveBuffer(outputSink, MAX_RECORD_LENGTH) == -1)
+        return -1;
+
+    switch (outputSink->format)
+    {
+    case FORMAT_TEXT:
+        appendText(outputSink, "Line: ", 6);
+        appendNumber(outputSink, line);
+        appendText(outputSink, ", characters: ", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "\n", 1);
+        break;
+    case FORMAT_JSON:
+        appendText(outputSink, "{\"line\":", 8);
+        appendNumber(outputSink, line);
+        appendText(outputSink, ",\"characters\":", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "}\n", 2);
+        break;
+    case FORMAT_BINARY:
+        appendBinary(outputSink, line);
+        appendBinary(outputSink, characters);
+        break;
+    }
+
+    outputSink->isLineOpen = false;
+    recordDifference(&outputSink->statistics, characters);
+
+    return 0;
+}
+
+/**
+ * @brief Appends the line number, or the replacement if the line is missing (0), to the buffer,
+ * which has to have enough space.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param line The line number or 0
+ * @param missing The characters which are appended for a missing line
+ * @param missingLength Amount of those characters
+ */
+static void appendLine(struct outputSink *outputSink, uint64_t line, const char *missing, size_t missingLength)
+{
+    if (line == 0)
+        appendText(outputSink, missing, missingLength);
+    else
+        appendNumber(outputSink, line);
+}
+
+int writeAlignedDifference(struct outputSink *outputSink, uint64_t line1, uint64_t line2, uint64_t characters)
+{
+    if (reserveBuffer(outputSink, MAX_RECORD_LENGTH + 20) == -1)
+        return -1;
+
+    switch (outputSink->format)
+    {
+    case FORMAT_TEXT:
+        appendText(outputSink, "Line: ", 6);
+        appendLine(outputSink, line1, "-", 1);
+        appendText(outputSink, "/", 1);
+        appendLine(outputSink, line2, "-", 1);
+        appendText(outputSink, ", characters: ", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "\n", 1);
+        break;
+    case FORMAT_JSON:
+        appendText(outputSink, "{\"line1\":", 9);
+        appendLine(outputSink, line1, "null", 4);
+        appendText(outputSink, ",\"line2\":", 9);
+        appendLine(outputSink, line2, "null", 4);
+        appendText(outputSink, ",\"characters\":", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "}\n", 2);
+        break;
+    case FORMAT_BINARY:
+        appendBinary(outputSink, line1);
+        appendBinary(outputSink, line2);
+        appendBinary(outputSink, characters);
+        break;
+    }
+
+    outputSink->isLineOpen = false;
+    recordDifference(&outputSink->statistics, characters);
+
+    return 0;
+}
+
+int writeNoDifferences(struct outputSink *outputSink)
+{
+    static const char message[] = "No differences found!";
+
+    if (outputSink->format != FORMAT_TEXT)
+        return 0;
+
+    if (reserveBuffer(outputSink, sizeof(message) - 1) == -1)
+        return -1;
+
+    appendText(outputSink, message, sizeof(message) - 1);
+    outputSink->isLineOpen = true;
+
+    return 0;
+}
+
+int writeTotals(struct outputSink *outputSink, uint64_t lines, uint64_t characters)
+{
+    if (reserveBuffer(outputSink, MAX_RECORD_LENGTH) == -1)
+        return -1;
+
+    switch (outputSink->format)
+    {
+    case FORMAT_TEXT:
+        appendText(outputSink, "Different lines: ", 17);
+        appendNumber(outputSink, lines);
+        appendText(outputSink, ", characters: ", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "\n", 1);
+        break;
+    case FORMAT_JSON:
+        appendText(outputSink, "{\"lines\":", 9);
+        appendNumber(outputSink, lines);
+        appendText(outputSink, ",\"characters\":", 14);
+        appendNumber(outputSink, characters);
+        appendText(outputSink, "}\n", 2);
+        break;
+    case FORMAT_BINARY:
+        appendBinary(outputSink, lines);
+        appendBinary(outputSink, characters);
+        break;
+    }
+
+    outputSink->isLineOpen = false;
+
+    return 0;
+}
+
+/**
+ * @brief Appends the filename as JSON string (with quotes) to the buffer, which has to have
+ * enough space for 6 characters per character of the filename and the quotes.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param fileName The filename which should be appended
+ */
+static void appendJsonString(struct outputSink *outputSink, const char *fileName)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    appendText(outputSink, "\"", 1);
+    for (const unsigned char *c = (const unsigned char *)fileName; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            char escaped[2] = {'\\', *c};
+            appendText(outputSink, escaped, 2);
+        }
+        else if (*c < 0x20)
+        {
+            char escaped[6] = {'\\', 'u', '0', '0', hexDigits[*c >> 4], hexDigits[*c & 0xF]};
+            appendText(outputSink, escaped, 6);
+        }
+        else
+        {
+            outputSink->buffer[outputSink->length++] = *c;
+        }
+    }
+    appendText(outputSink, "\"", 1);
+}
+
+int writeFileHeader(struct outputSink *outputSink, const char *fileName, uint64_t index)
+{
+    size_t nameLength = strlen(fileName);
+    if (reserveBuffer(outputSink, nameLength * 6 + MAX_RECORD_LENGTH) == -1)
+        return -1;
+
+    switch (outputSink->format)
+    {
+    case FORMAT_TEXT:
+        if (outputSink->isLineOpen == true)
+            appendText(outputSink, "\n", 1);
+        appendText(outputSink, "File: ", 6);
+        appendText(outputSink, fileName, nameLength);
+        appendText(outputSink, "\n", 1);
+        break;
+    case FORMAT_JSON:
+        appendText(outputSink, "{\"file\":", 8);
+        appendJsonString(outputSink, fileName);
+        appendText(outputSink, ",\"index\":", 9);
+        appendNumber(outputSink, index);
+        appendText(outputSink, "}\n", 2);
+        break;
+    case FORMAT_BINARY:
+        appendBinary(outputSink, 0);
+        appendBinary(outputSink, index);
+        break;
+    }
+
+    outputSink->isLineOpen = false;
+
+    return 0;
+}
+
+int writeFileError(struct outputSink *outputSink, int error)
+{
+    const char *message = strerror(error);
+    size_t messageLength = strlen(message);
+    if (reserveBuffer(outputSink, messageLength * 6 + MAX_RECORD_LENGTH) == -1)
+        return -1;
+
+    switch (outputSink->format)
+    {
+    case FORMAT_TEXT:
+        appendText(outputSink, "Error: ", 7);
+        appendText(outputSink, message, messageLength);
+        appendText(outputSink, "\n", 1);
+        break;
+    case FORMAT_JSON:
+        appendText(outputSink, "{\"error\":", 9);
+        appendJsonString(outputSink, message);
+        appendText(outputSink, "}\n", 2);
+        break;
+    case FORMAT_BINARY:
+        appendBinary(outputSink, UINT64_MAX);
+        appendBinary(outputSink, error);
+        break;
+    }
+
+    outputSink->isLineOpen = false;
+
+    return 0;
+}
+
+int moveOutputSink(struct outputSink *outputSink, struct outputSink *source)
+{
+    if (outputSink->file != NULL && source->length > outputSink->capacity - outputSink->length)
+    {
+        // write large outputs directly instead of copying them into the buffer first
+        if (writeBuffer(outputSink) == -1 || fwrite(source->buffer, 1, source->length, outputSink->file) != source->length)
+            return -1;
+    }
+    else
+    {
+        if (reserveBuffer(outputSink, source->length) == -1)
+            return -1;
+
+        appendText(outputSink, source->buffer, source->length);
+    }
+
+    if (source->length > 0)
+        outputSink->isLineOpen = source->isLineOpen;
+    source->length = 0;
+
+    mergeStatistics(&outputSink->statistics, &source->statistics);
+    memset(&source->statistics, 0, sizeof(struct diffStatistics));
+
+    return 0;
+}
+
+int flushOutputSink(struct outputSink *outputSink)
+{
+    if (outputSink->file == NULL)
+        return 0;
+
+    if (writeBuffer(outputSink) == -1 || fflush(outputSink->file) == EOF)
+        return -1;
+
+    return 0;
+}
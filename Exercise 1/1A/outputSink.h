@@ -0,0 +1,185 @@
+/**
+ * @file outputSink.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines open/close/write/flush for the output-sink.
+ *
+ * This module defines the structure for the output-sink and the functions
+ * concerning it. The output-sink formats the records of the differing lines
+ * into a large buffer (without printf) and writes this buffer to the output
+ * in large blocks. The records can be formatted as text (Line: N, characters: M),
+ * as newline-delimited JSON or as fixed-size binary records. If several files
+ * are compared with one reference, each report starts with a file-header.
+ * Every written difference is also counted in the statistics of the output-sink.
+ */
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "diffStatistics.h"
+
+/**
+ * @brief Size of the buffer in bytes, after which the output-sink writes to the file
+ */
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+/**
+ * @brief Size of a binary record in bytes
+ * @details A binary record contains the line and the amount of different characters
+ * as unsigned 64-bit integers in little-endian byte order.
+ */
+#define BINARY_RECORD_SIZE 16
+
+/**
+ * @brief Size of a binary record of an aligned comparison in bytes
+ * @details A binary record contains the line of the first file, the line of the second
+ * file and the edit distance as unsigned 64-bit integers in little-endian byte order.
+ * A missing line (deleted or inserted line) is 0.
+ */
+#define ALIGNED_RECORD_SIZE 24
+
+/**
+ * @brief Formats of the records written by the output-sink
+ * @details FORMAT_TEXT: "Line: N, characters: M\n"
+ * FORMAT_JSON: {"line":N,"characters":M}\n
+ * FORMAT_BINARY: records of BINARY_RECORD_SIZE bytes
+ */
+enum outputFormat
+{
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_BINARY
+};
+
+/**
+ * @brief Datatype of the output-sink
+ * @details If the file is NULL, the output-sink only collects the records in memory
+ * (e.g. for one chunk of a multi-threaded comparison) and never writes them.
+ * isLineOpen is true, if the last written text doesn't end with a linebreak.
+ * The statistics count the differences, which were written to the output-sink
+ * (or moved from another output-sink).
+ */
+struct outputSink
+{
+    FILE *file;
+    enum outputFormat format;
+    char *buffer;
+    size_t length;
+    size_t capacity;
+    bool isLineOpen;
+    struct diffStatistics statistics;
+};
+
+/**
+ * @brief This function creates an output-sink for the specified file and format.
+ *
+ * @param file Pointer to the output stream, or NULL for an output-sink which only collects the records in memory
+ * @param format The format of the records
+ * @return Pointer to an output-sink, if the creation was successfull, otherwise NULL
+ */
+struct outputSink *openOutputSink(FILE *file, enum outputFormat format);
+
+/**
+ * @brief This function frees the output-sink. The buffer is not flushed and the file is not closed.
+ * @details The output-sink should not be used after returning from this call.
+ *
+ * @param outputSink Pointer to the output-sink which should be closed
+ */
+void closeOutputSink(struct outputSink *outputSink);
+
+/**
+ * @brief This function writes the record of a differing line to the output-sink.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param line Number of the line (starting with 1)
+ * @param characters Amount of different characters in this line
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeDifference(struct outputSink *outputSink, uint64_t line, uint64_t characters);
+
+/**
+ * @brief This function writes the record of a differing line of an aligned comparison.
+ * @details FORMAT_TEXT: "Line: N1/N2, characters: M\n" (- for a missing line)
+ * FORMAT_JSON: {"line1":N1,"line2":N2,"characters":M}\n (null for a missing line)
+ * FORMAT_BINARY: records of ALIGNED_RECORD_SIZE bytes (0 for a missing line)
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param line1 Number of the line in the first file (starting with 1), 0 if the line was inserted
+ * @param line2 Number of the line in the second file (starting with 1), 0 if the line was deleted
+ * @param characters Edit distance of the lines (or length of a deleted/inserted line)
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeAlignedDifference(struct outputSink *outputSink, uint64_t line1, uint64_t line2, uint64_t characters);
+
+/**
+ * @brief This function writes the message, that no differences were found. Only the text
+ * format contains this message, in the other formats no records means no differences.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeNoDifferences(struct outputSink *outputSink);
+
+/**
+ * @brief This function writes the totals of a comparison, which only counts the differences.
+ * @details FORMAT_TEXT: "Different lines: N, characters: M\n"
+ * FORMAT_JSON: {"lines":N,"characters":M}\n
+ * FORMAT_BINARY: a record with the amount of lines and characters
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param lines Amount of different lines
+ * @param characters Amount of different characters of all lines
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeTotals(struct outputSink *outputSink, uint64_t lines, uint64_t characters);
+
+/**
+ * @brief This function writes the header of the report of a file, which is compared with a reference.
+ * @details FORMAT_TEXT: "File: name\n" (after a linebreak, if the previous report ends without one)
+ * FORMAT_JSON: {"file":"name","index":N}\n
+ * FORMAT_BINARY: a record with the line 0 and the index as amount of characters
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param fileName The filename/path of the compared file
+ * @param index Position of the file in the list of compared files (starting with 1)
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeFileHeader(struct outputSink *outputSink, const char *fileName, uint64_t index);
+
+/**
+ * @brief This function writes the error, because of which the file of the last file-header
+ * couldn't be compared, instead of its records.
+ * @details FORMAT_TEXT: "Error: message\n"
+ * FORMAT_JSON: {"error":"message"}\n
+ * FORMAT_BINARY: a record with the line UINT64_MAX and the errno as amount of characters
+ *
+ * @param outputSink Pointer to the output-sink
+ * @param error The errno of the failed call
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int writeFileError(struct outputSink *outputSink, int error);
+
+/**
+ * @brief This function writes the collected records of another output-sink (in memory)
+ * to this output-sink, adds its statistics and empties the other output-sink.
+ *
+ * @param outputSink Pointer to the output-sink, which gets the records
+ * @param source Pointer to the output-sink, whose records should be moved
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int moveOutputSink(struct outputSink *outputSink, struct outputSink *source);
+
+/**
+ * @brief This function writes the buffer to the file and flushes the file.
+ *
+ * @param outputSink Pointer to the output-sink
+ * @return 0 on success and -1 on error (errno is set)
+ */
+int flushOutputSink(struct outputSink *outputSink);
+
+#endif
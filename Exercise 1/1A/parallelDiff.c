@@ -0,0 +1,399 @@
+/**
+ * @file parallelDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the multi-threaded comparison of two mapped files.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lineDiff.h"
+#include "parallelDiff.h"
+
+/**
+ * @brief Data structure to store a chunk of the first file and its result
+ * @details The chunk starts at a line and ends after a linebreak (or at the end of
+ * the file). The report collects the formatted records of the differing lines in memory.
+ */
+struct chunk
+{
+    size_t start;
+    size_t end;
+    size_t linebreaks;
+    size_t firstLine;
+    struct lineReport report;
+    bool isDone;
+    bool hasFailed;
+};
+
+/**
+ * @brief Data structure which is shared between all worker-threads
+ * @details The second file is split into slices of CHUNK_SIZE bytes, which don't have
+ * to be line-aligned. linebreaksBefore2[i] is the amount of linebreaks before slice i,
+ * so that the start of a line in the second file can be found without searching the
+ * whole file. nextItem, mergedChunks and the flags of the chunks are protected by the mutex.
+ * If itemWindow isn't 0, an item can only be taken, while less than itemWindow items
+ * before it are not merged yet (mergedChunks counts the merged chunks).
+ */
+struct parallelDiff
+{
+    const char *data1;
+    const char *data2;
+    size_t size1;
+    size_t size2;
+    size_t totalLines2;
+    enum outputFormat format;
+    diffKernel kernel;
+    struct chunk *chunks;
+    size_t chunkCount;
+    size_t *linebreaksBefore2;
+    size_t sliceCount2;
+    size_t itemCount;
+    size_t nextItem;
+    size_t itemWindow;
+    size_t mergedChunks;
+    pthread_mutex_t mutex;
+    pthread_cond_t chunkDone;
+    pthread_cond_t chunkMerged;
+};
+
+/**
+ * @brief Takes the next work-item, which isn't processed by another thread yet. If the
+ * item is too far ahead of the merged chunks (itemWindow), it waits until enough chunks
+ * are merged.
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param item Pointer which will be set to the index of the taken item
+ * @return true if an item was taken, false if all items are already taken
+ */
+static bool takeItem(struct parallelDiff *diff, size_t *item)
+{
+    pthread_mutex_lock(&diff->mutex);
+
+    while (diff->itemWindow > 0 && diff->nextItem < diff->itemCount && diff->nextItem - diff->mergedChunks >= diff->itemWindow)
+        pthread_cond_wait(&diff->chunkMerged, &diff->mutex);
+
+    bool hasItem = diff->nextItem < diff->itemCount;
+    if (hasItem == true)
+        *item = diff->nextItem++;
+
+    pthread_mutex_unlock(&diff->mutex);
+
+    return hasItem;
+}
+
+/**
+ * @brief Worker-thread which counts the linebreaks of the chunks of the first file
+ * and of the slices of the second file
+ *
+ * @param argument Pointer to the shared data of the comparison
+ * @return Always NULL
+ */
+static void *countWorker(void *argument)
+{
+    struct parallelDiff *diff = argument;
+    size_t item;
+
+    while (takeItem(diff, &item) == true)
+    {
+        if (item < diff->chunkCount)
+        {
+            struct chunk *chunk = &diff->chunks[item];
+            chunk->linebreaks = countLinebreaks(diff->data1 + chunk->start, chunk->end - chunk->start);
+        }
+
+        if (item < diff->sliceCount2)
+        {
+            size_t start = item * CHUNK_SIZE;
+            size_t end = (start + CHUNK_SIZE < diff->size2) ? start + CHUNK_SIZE : diff->size2;
+            diff->linebreaksBefore2[item + 1] = countLinebreaks(diff->data2 + start, end - start);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Returns the offset of the first character of the specified line in the second file
+ * @details The line has to be smaller than the total amount of lines of the second file.
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param line Index of the line (starting with 0)
+ * @return Offset of the line in the second file
+ */
+static size_t findLineStart(const struct parallelDiff *diff, size_t line)
+{
+    if (line == 0)
+        return 0;
+
+    // binary search for the slice, which contains the line-th linebreak
+    size_t low = 0, high = diff->sliceCount2 - 1;
+    while (low < high)
+    {
+        size_t middle = (low + high + 1) / 2;
+        if (diff->linebreaksBefore2[middle] < line)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    const char *position = diff->data2 + low * CHUNK_SIZE;
+    const char *end = diff->data2 + diff->size2;
+    for (size_t remaining = line - diff->linebreaksBefore2[low]; remaining > 0; remaining--)
+        position = (const char *)memchr(position, '\n', end - position) + 1;
+
+    return position - diff->data2;
+}
+
+/**
+ * @brief Compares the lines of one chunk with the matching lines of the second file
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param chunk Pointer to the chunk which should be compared
+ * @return 0 on success and -1 if the allocation of the output failed
+ */
+static int compareChunk(const struct parallelDiff *diff, struct chunk *chunk)
+{
+    if (chunk->start == chunk->end || chunk->firstLine >= diff->totalLines2)
+        return 0;
+
+    size_t start2 = findLineStart(diff, chunk->firstLine);
+
+    struct lineReader lineReader1, lineReader2;
+    initMemoryLineReader(&lineReader1, diff->data1 + chunk->start, chunk->end - chunk->start);
+    initMemoryLineReader(&lineReader2, diff->data2 + start2, diff->size2 - start2);
+
+    // the report is only opened for chunks with differences
+    chunk->report.format = diff->format;
+    return (compareLineReaders(&lineReader1, &lineReader2, diff->kernel, chunk->firstLine + 1, 1, UINT64_MAX, &chunk->report) == -1) ? -1 : 0;
+}
+
+/**
+ * @brief Worker-thread which compares the chunks and signals the merging thread
+ * after every chunk
+ *
+ * @param argument Pointer to the shared data of the comparison
+ * @return Always NULL
+ */
+static void *compareWorker(void *argument)
+{
+    struct parallelDiff *diff = argument;
+    size_t item;
+
+    while (takeItem(diff, &item) == true)
+    {
+        struct chunk *chunk = &diff->chunks[item];
+        bool hasFailed = compareChunk(diff, chunk) == -1;
+
+        pthread_mutex_lock(&diff->mutex);
+        chunk->hasFailed = hasFailed;
+        chunk->isDone = true;
+        pthread_cond_broadcast(&diff->chunkDone);
+        pthread_mutex_unlock(&diff->mutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Starts the worker-threads and waits for them to finish. If a thread can't be
+ * started the already started threads still finish the work.
+ *
+ * @param threads Array for the thread-ids
+ * @param threadCount Amount of threads which should be started
+ * @param worker The function which is executed by each thread
+ * @param diff Pointer to the shared data of the comparison
+ * @return The amount of threads which were started
+ */
+static int startWorkers(pthread_t *threads, int threadCount, void *(*worker)(void *), struct parallelDiff *diff)
+{
+    int started = 0;
+    while (started < threadCount && pthread_create(&threads[started], NULL, worker, diff) == 0)
+        started++;
+
+    return started;
+}
+
+/**
+ * @brief Waits for the specified threads to finish
+ *
+ * @param threads Array of the thread-ids
+ * @param threadCount Amount of threads
+ */
+static void joinWorkers(pthread_t *threads, int threadCount)
+{
+    for (int i = 0; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+}
+
+/**
+ * @brief Splits the first file into chunks which start at the beginning of a line
+ *
+ * @param diff Pointer to the shared data of the comparison
+ */
+static void splitChunks(struct parallelDiff *diff)
+{
+    diff->chunks[0].start = 0;
+
+    for (size_t i = 1; i < diff->chunkCount; i++)
+    {
+        size_t previousStart = diff->chunks[i - 1].start;
+        if (previousStart >= i * CHUNK_SIZE)
+        {
+            // the previous chunk is empty, because a line is longer than a chunk
+            diff->chunks[i].start = previousStart;
+        }
+        else
+        {
+            diff->chunks[i].start = alignToLineStart(diff->data1, diff->size1, i * CHUNK_SIZE);
+        }
+
+        diff->chunks[i - 1].end = diff->chunks[i].start;
+    }
+
+    diff->chunks[diff->chunkCount - 1].end = diff->size1;
+}
+
+/**
+ * @brief Writes the outputs of the chunks in their order, as soon as a chunk is done
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @return The amount of different lines or -1 if a chunk failed or writing failed
+ */
+static int64_t mergeChunks(struct parallelDiff *diff, struct outputSink *outputSink)
+{
+    int64_t differentLines = 0;
+
+    for (size_t i = 0; i < diff->chunkCount; i++)
+    {
+        struct chunk *chunk = &diff->chunks[i];
+
+        pthread_mutex_lock(&diff->mutex);
+        while (chunk->isDone == false)
+            pthread_cond_wait(&diff->chunkDone, &diff->mutex);
+        pthread_mutex_unlock(&diff->mutex);
+
+        if (chunk->hasFailed == true || (chunk->report.output != NULL && moveOutputSink(outputSink, chunk->report.output) == -1))
+        {
+            // stop the other workers from taking new chunks (also the waiting ones)
+            pthread_mutex_lock(&diff->mutex);
+            diff->nextItem = diff->itemCount;
+            pthread_cond_broadcast(&diff->chunkMerged);
+            pthread_mutex_unlock(&diff->mutex);
+
+            if (chunk->hasFailed == true)
+                errno = ENOMEM;
+            return -1;
+        }
+
+        differentLines += chunk->report.differentLines;
+
+        if (chunk->report.output != NULL)
+        {
+            closeOutputSink(chunk->report.output);
+            chunk->report.output = NULL;
+        }
+
+        // let the workers take the next chunk
+        pthread_mutex_lock(&diff->mutex);
+        diff->mergedChunks++;
+        pthread_cond_broadcast(&diff->chunkMerged);
+        pthread_mutex_unlock(&diff->mutex);
+    }
+
+    return differentLines;
+}
+
+int64_t compareFilesParallel(const struct lineReader *lineReader1, const struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, int threadCount)
+{
+    // there is nothing to compare, if one of the files is empty
+    if (lineReader1->end == 0 || lineReader2->end == 0)
+        return 0;
+
+    struct parallelDiff diff;
+    diff.data1 = lineReader1->buffer;
+    diff.data2 = lineReader2->buffer;
+    diff.size1 = lineReader1->end;
+    diff.size2 = lineReader2->end;
+    diff.format = outputSink->format;
+    diff.kernel = kernel;
+    diff.chunkCount = (diff.size1 + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    diff.sliceCount2 = (diff.size2 + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    diff.chunks = calloc(diff.chunkCount, sizeof(struct chunk));
+    diff.linebreaksBefore2 = calloc(diff.sliceCount2 + 1, sizeof(size_t));
+
+    pthread_t *threads = malloc(threadCount * sizeof(pthread_t));
+    if (diff.chunks == NULL || diff.linebreaksBefore2 == NULL || threads == NULL)
+    {
+        free(diff.chunks);
+        free(diff.linebreaksBefore2);
+        free(threads);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    pthread_mutex_init(&diff.mutex, NULL);
+    pthread_cond_init(&diff.chunkDone, NULL);
+    pthread_cond_init(&diff.chunkMerged, NULL);
+
+    // count the lines of all chunks and slices in parallel
+    splitChunks(&diff);
+    diff.itemCount = (diff.chunkCount > diff.sliceCount2) ? diff.chunkCount : diff.sliceCount2;
+    diff.nextItem = 0;
+    diff.itemWindow = 0;
+    diff.mergedChunks = 0;
+
+    int started = startWorkers(threads, threadCount, &countWorker, &diff);
+    if (started == 0)
+        countWorker(&diff);
+    joinWorkers(threads, started);
+
+    for (size_t i = 0; i < diff.sliceCount2; i++)
+        diff.linebreaksBefore2[i + 1] += diff.linebreaksBefore2[i];
+
+    for (size_t i = 1; i < diff.chunkCount; i++)
+        diff.chunks[i].firstLine = diff.chunks[i - 1].firstLine + diff.chunks[i - 1].linebreaks;
+
+    // a last line without linebreak counts as line too
+    diff.totalLines2 = diff.linebreaksBefore2[diff.sliceCount2];
+    if (diff.size2 > 0 && diff.data2[diff.size2 - 1] != '\n')
+        diff.totalLines2++;
+
+    // compare the chunks in parallel and merge their outputs in this thread, which holds the workers back
+    diff.itemCount = diff.chunkCount;
+    diff.nextItem = 0;
+    diff.itemWindow = (size_t)CHUNKS_AHEAD_PER_THREAD * threadCount;
+
+    int64_t differentLines;
+    started = startWorkers(threads, threadCount, &compareWorker, &diff);
+    if (started == 0)
+    {
+        errno = EAGAIN;
+        differentLines = -1;
+    }
+    else
+    {
+        differentLines = mergeChunks(&diff, outputSink);
+        joinWorkers(threads, started);
+    }
+
+    for (size_t i = 0; i < diff.chunkCount; i++)
+    {
+        if (diff.chunks[i].report.output != NULL)
+            closeOutputSink(diff.chunks[i].report.output);
+    }
+
+    pthread_cond_destroy(&diff.chunkDone);
+    pthread_cond_destroy(&diff.chunkMerged);
+    pthread_mutex_destroy(&diff.mutex);
+    free(diff.chunks);
+    free(diff.linebreaksBefore2);
+    free(threads);
+
+    return differentLines;
+}
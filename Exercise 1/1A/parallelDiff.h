@@ -0,0 +1,50 @@
+/**
+ * @file parallelDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the multi-threaded comparison of two mapped files.
+ *
+ * The first file is split into line-aligned chunks and for every chunk the
+ * matching line in the second file is searched. Worker-threads compare the
+ * chunks in parallel and write their results into an own buffer per chunk.
+ * The calling thread merges those buffers in the order of the chunks, so
+ * the output is the same as the one of the single-threaded comparison.
+ * The workers only run a limited amount of chunks ahead of the merging, so
+ * a slow output (e.g. a pipe) doesn't let the buffers grow with the result.
+ */
+
+#ifndef PARALLELDIFF_H
+#define PARALLELDIFF_H
+
+#include "diffKernel.h"
+#include "lineReader.h"
+#include "outputSink.h"
+
+/**
+ * @brief Size of a chunk in bytes, which is compared by one worker-thread at once
+ */
+#define CHUNK_SIZE (16 << 20)
+
+/**
+ * @brief Amount of chunks per worker-thread, which may be taken before they are merged
+ */
+#define CHUNKS_AHEAD_PER_THREAD 2
+
+/**
+ * @brief This function compares the two files line by line with the specified amount
+ * of worker-threads and writes the differing lines to the output in the same format
+ * and order as the single-threaded comparison.
+ * @details Both line-readers have to be mapped (isMapped), because the chunks are read
+ * directly from the mapped pages. The line-readers are not modified.
+ *
+ * @param lineReader1 Pointer to the mapped line-reader of the first input-file
+ * @param lineReader2 Pointer to the mapped line-reader of the second input-file
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param kernel The kernel which counts the differing characters per line
+ * @param threadCount The amount of worker-threads which should be started
+ * @return The amount of different lines or -1 if an error occured (errno is set)
+ */
+int64_t compareFilesParallel(const struct lineReader *lineReader1, const struct lineReader *lineReader2, struct outputSink *outputSink, diffKernel kernel, int threadCount);
+
+#endif
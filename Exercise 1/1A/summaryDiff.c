@@ -0,0 +1,136 @@
+/**
+ * @file summaryDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the comparison, which only counts the differences.
+ */
+
+#include <string.h>
+#include "summaryDiff.h"
+
+/**
+ * @brief Returns the offset after the last linebreak of the memory area
+ *
+ * @param data Pointer to the first character of the memory area
+ * @param length Length of the memory area
+ * @return Offset after the last linebreak, or 0 if the memory area contains no linebreak
+ */
+static size_t findLastLineEnd(const char *data, size_t length)
+{
+    while (length > 0 && data[length - 1] != '\n')
+        length--;
+
+    return length;
+}
+
+/**
+ * @brief Returns the length of the line, which starts at the first character of the memory area
+ *
+ * @param data Pointer to the first character of the line
+ * @param remaining Amount of characters until the end of the file
+ * @param hasLinebreak Pointer which will be set to true, if the line ends with a linebreak
+ * @return The length of the line without the linebreak
+ */
+static size_t findLineLength(const char *data, size_t remaining, bool *hasLinebreak)
+{
+    const char *end = memchr(data, '\n', remaining);
+    *hasLinebreak = end != NULL;
+
+    return (end != NULL) ? (size_t)(end - data) : remaining;
+}
+
+/**
+ * @brief Counts the differences of two mapped files, whose identical runs are skipped with memcmp
+ *
+ * @param data1 Pointer to the content of the first file
+ * @param size1 Size of the first file
+ * @param data2 Pointer to the content of the second file
+ * @param size2 Size of the second file
+ * @param kernel The kernel which counts the differing characters per line
+ * @param stopAtFirst If true, the comparison stops after the first different line
+ * @param summary Pointer to the totals
+ */
+static void summarizeMapped(const char *data1, size_t size1, const char *data2, size_t size2, diffKernel kernel, bool stopAtFirst, struct diffSummary *summary)
+{
+    size_t position1 = 0, position2 = 0, run = SUMMARY_MIN_RUN;
+
+    // both positions are always at the start of a line
+    while (position1 < size1 && position2 < size2)
+    {
+        size_t remaining1 = size1 - position1, remaining2 = size2 - position2;
+        size_t length = run;
+        if (length > remaining1)
+            length = remaining1;
+        if (length > remaining2)
+            length = remaining2;
+
+        if (memcmp(data1 + position1, data2 + position2, length) == 0)
+        {
+            // the remaining lines of the shorter file are a prefix of the lines of the other file
+            if (length == remaining1 || length == remaining2)
+                return;
+
+            size_t lineEnd = findLastLineEnd(data1 + position1, length);
+            if (lineEnd > 0)
+            {
+                position1 += lineEnd;
+                position2 += lineEnd;
+                if (run < SUMMARY_MAX_RUN)
+                    run *= 2;
+                continue;
+            }
+        }
+        else
+        {
+            run = SUMMARY_MIN_RUN;
+        }
+
+        // compare the first line of the differing run (or a line longer than the run)
+        bool hasLinebreak1, hasLinebreak2;
+        size_t length1 = findLineLength(data1 + position1, remaining1, &hasLinebreak1);
+        size_t length2 = findLineLength(data2 + position2, remaining2, &hasLinebreak2);
+
+        size_t differencePerLine = kernel(data1 + position1, data2 + position2, (length1 < length2) ? length1 : length2);
+        if (differencePerLine > 0)
+        {
+            summary->differentLines++;
+            summary->differentCharacters += differencePerLine;
+            if (stopAtFirst == true)
+                return;
+        }
+
+        position1 += length1 + hasLinebreak1;
+        position2 += length2 + hasLinebreak2;
+    }
+}
+
+int summarizeFiles(struct lineReader *lineReader1, struct lineReader *lineReader2, diffKernel kernel, bool stopAtFirst, struct diffSummary *summary)
+{
+    summary->differentLines = 0;
+    summary->differentCharacters = 0;
+
+    if (lineReader1->isMapped == true && lineReader2->isMapped == true)
+    {
+        summarizeMapped(lineReader1->buffer, lineReader1->end, lineReader2->buffer, lineReader2->end, kernel, stopAtFirst, summary);
+        return 0;
+    }
+
+    const char *line1, *line2;
+    size_t length1, length2;
+    int status1, status2 = 0;
+
+    while ((status1 = readLine(lineReader1, &line1, &length1)) == 1 && (status2 = readLine(lineReader2, &line2, &length2)) == 1)
+    {
+        size_t differencePerLine = kernel(line1, line2, (length1 < length2) ? length1 : length2);
+        if (differencePerLine > 0)
+        {
+            summary->differentLines++;
+            summary->differentCharacters += differencePerLine;
+            if (stopAtFirst == true)
+                return 0;
+        }
+    }
+
+    return (status1 == -1 || status2 == -1) ? -1 : 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file summaryDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the comparison, which only counts the differences.
+ *
+ * If both files are mapped, the files are compared with memcmp in runs of
+ * whole blocks first. All lines which end inside an identical run are identical
+ * too, so only the lines of a differing run have to be compared one by one.
+ * The runs grow while the files are identical and shrink to SUMMARY_MIN_RUN at
+ * the first difference, so identical files are confirmed at the speed of memcmp
+ * and differing lines don't cost much more than in the line by line comparison.
+ */
+
+#ifndef SUMMARYDIFF_H
+#define SUMMARYDIFF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "diffKernel.h"
+#include "lineReader.h"
+
+/**
+ * @brief Size of a run in bytes, which is compared with memcmp after a difference
+ */
+#define SUMMARY_MIN_RUN (4 << 10)
+
+/**
+ * @brief Maximal size of a run in bytes, which is compared with memcmp at once
+ */
+#define SUMMARY_MAX_RUN (1 << 20)
+
+/**
+ * @brief Datatype of the totals of a comparison
+ */
+struct diffSummary
+{
+    uint64_t differentLines;
+    uint64_t differentCharacters;
+};
+
+/**
+ * @brief This function compares the two files line by line (up to the end of the shorter file)
+ * and counts the different lines and the different characters of all lines.
+ * @details If both line-readers are mapped the identical runs are skipped with memcmp,
+ * otherwise the lines are read one after another.
+ *
+ * @param lineReader1 Pointer to the line-reader of the first input-file
+ * @param lineReader2 Pointer to the line-reader of the second input-file
+ * @param kernel The kernel which counts the differing characters per line
+ * @param stopAtFirst If true, the comparison stops after the first different line
+ * @param summary Pointer to the totals, which are set by this function
+ * @return 0 on success and -1 if reading one of the files failed (errno is set)
+ */
+int summarizeFiles(struct lineReader *lineReader1, struct lineReader *lineReader2, diffKernel kernel, bool stopAtFirst, struct diffSummary *summary);
+
+#endif
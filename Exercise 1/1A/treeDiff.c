@@ -0,0 +1,477 @@
+/**
+ * @file treeDiff.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the comparison of two directory-trees.
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lineDiff.h"
+#include "lineReader.h"
+#include "treeDiff.h"
+
+/**
+ * @brief Data structure to store a pair of files and its result
+ * @details The report collects the formatted records of the differing lines in memory.
+ * The error is the errno of the failed call (errno is thread-local) or 0. An item with
+ * an error when it is queued (a directory, which can't be read) isn't compared.
+ */
+struct treeItem
+{
+    char *relativePath;
+    struct lineReport report;
+    int error;
+    bool isDone;
+};
+
+/**
+ * @brief Data structure which is shared between the walking thread and the worker-threads
+ * @details The items are used as ring-buffer: pushed, taken and written count the pairs,
+ * which were queued, taken by a worker-thread and written to the output. The walking
+ * thread never has more than TREE_QUEUE_SIZE pairs, which are not written yet. pushed,
+ * taken, isClosed and the flags of the items are protected by the mutex. failedPairs
+ * counts the written pairs with an error, the error stops the whole comparison.
+ */
+struct treeDiff
+{
+    const char *directory1;
+    const char *directory2;
+    enum outputFormat format;
+    diffKernel kernel;
+    struct treeItem *items;
+    size_t pushed;
+    size_t taken;
+    size_t written;
+    bool isClosed;
+    struct outputSink *outputSink;
+    int64_t differentLines;
+    uint64_t failedPairs;
+    int error;
+    pthread_mutex_t mutex;
+    pthread_cond_t itemQueued;
+    pthread_cond_t itemDone;
+};
+
+/**
+ * @brief Joins a directory and a relative path with a slash
+ *
+ * @param directory The path of the directory
+ * @param relativePath The relative path (may be empty)
+ * @return The allocated path or NULL if the allocation failed
+ */
+static char *joinPath(const char *directory, const char *relativePath)
+{
+    size_t directoryLength = strlen(directory), relativeLength = strlen(relativePath);
+    char *path = malloc(directoryLength + relativeLength + 2);
+    if (path == NULL)
+        return NULL;
+
+    memcpy(path, directory, directoryLength);
+    path[directoryLength] = '/';
+    memcpy(path + directoryLength + 1, relativePath, relativeLength + 1);
+
+    return path;
+}
+
+/**
+ * @brief Opens both files of the pair and compares them
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param item Pointer to the item, whose files should be compared
+ * @param path1 The path of the file in the first directory-tree
+ * @param path2 The path of the file in the second directory-tree
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int compareFiles(const struct treeDiff *diff, struct treeItem *item, const char *path1, const char *path2)
+{
+    int fd1 = open(path1, O_RDONLY);
+    if (fd1 == -1)
+        return -1;
+
+    int fd2 = open(path2, O_RDONLY);
+    if (fd2 == -1)
+    {
+        close(fd1);
+        return -1;
+    }
+
+    int result = -1;
+    struct lineReader *lineReader1 = openLineReader(fd1);
+    struct lineReader *lineReader2 = openLineReader(fd2);
+    if (lineReader1 == NULL || lineReader2 == NULL)
+        errno = ENOMEM;
+    else
+        result = (compareLineReaders(lineReader1, lineReader2, diff->kernel, 1, 1, UINT64_MAX, &item->report) == -1) ? -1 : 0;
+
+    if (lineReader1 != NULL)
+        closeLineReader(lineReader1);
+    if (lineReader2 != NULL)
+        closeLineReader(lineReader2);
+    close(fd1);
+    close(fd2);
+
+    return result;
+}
+
+/**
+ * @brief Compares the pair of the item, whose files have the same relative path in both directory-trees
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param item Pointer to the item, whose files should be compared
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int comparePair(const struct treeDiff *diff, struct treeItem *item)
+{
+    char *path1 = joinPath(diff->directory1, item->relativePath);
+    char *path2 = joinPath(diff->directory2, item->relativePath);
+
+    int result = -1;
+    if (path1 == NULL || path2 == NULL)
+        errno = ENOMEM;
+    else
+        result = compareFiles(diff, item, path1, path2);
+
+    free(path1);
+    free(path2);
+
+    return result;
+}
+
+/**
+ * @brief Worker-thread which takes the queued pairs, compares them and signals the
+ * walking thread after every pair
+ *
+ * @param argument Pointer to the shared data of the comparison
+ * @return Always NULL
+ */
+static void *compareWorker(void *argument)
+{
+    struct treeDiff *diff = argument;
+
+    while (true)
+    {
+        pthread_mutex_lock(&diff->mutex);
+        while (diff->taken == diff->pushed && diff->isClosed == false)
+            pthread_cond_wait(&diff->itemQueued, &diff->mutex);
+
+        if (diff->taken == diff->pushed)
+        {
+            pthread_mutex_unlock(&diff->mutex);
+            break;
+        }
+
+        struct treeItem *item = &diff->items[diff->taken++ % TREE_QUEUE_SIZE];
+        pthread_mutex_unlock(&diff->mutex);
+
+        int error = item->error;
+        if (error == 0 && comparePair(diff, item) == -1)
+            error = errno;
+
+        pthread_mutex_lock(&diff->mutex);
+        item->error = error;
+        item->isDone = true;
+        pthread_cond_broadcast(&diff->itemDone);
+        pthread_mutex_unlock(&diff->mutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Waits for the oldest pair, which isn't written yet, and writes its report or its error
+ * (the report of a failed pair is incomplete, so it is dropped). After an error of the whole
+ * comparison no more reports are written, but the pairs are still freed.
+ *
+ * @param diff Pointer to the shared data of the comparison
+ */
+static void writeItem(struct treeDiff *diff)
+{
+    struct treeItem *item = &diff->items[diff->written % TREE_QUEUE_SIZE];
+
+    pthread_mutex_lock(&diff->mutex);
+    while (item->isDone == false)
+        pthread_cond_wait(&diff->itemDone, &diff->mutex);
+    pthread_mutex_unlock(&diff->mutex);
+
+    if (diff->error == 0 && item->error != 0)
+    {
+        if (writeFileHeader(diff->outputSink, item->relativePath, diff->written + 1) == -1 ||
+            writeFileError(diff->outputSink, item->error) == -1)
+            diff->error = errno;
+
+        diff->failedPairs++;
+    }
+    else if (diff->error == 0)
+    {
+        if (writeFileHeader(diff->outputSink, item->relativePath, diff->written + 1) == -1 ||
+            (item->report.output != NULL && moveOutputSink(diff->outputSink, item->report.output) == -1) ||
+            (item->report.differentLines == 0 && writeNoDifferences(diff->outputSink) == -1))
+            diff->error = errno;
+
+        diff->differentLines += item->report.differentLines;
+    }
+
+    if (item->report.output != NULL)
+        closeOutputSink(item->report.output);
+    free(item->relativePath);
+    diff->written++;
+}
+
+/**
+ * @brief Queues the pair with the specified relative path. If the queue is full, the reports
+ * of the oldest pairs are written first.
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param relativePath The allocated relative path, which is owned by the queue afterwards
+ * @param error The errno, which is reported instead of comparing the pair, or 0
+ */
+static void pushItem(struct treeDiff *diff, char *relativePath, int error)
+{
+    while (diff->pushed - diff->written == TREE_QUEUE_SIZE)
+        writeItem(diff);
+
+    struct treeItem *item = &diff->items[diff->pushed % TREE_QUEUE_SIZE];
+    item->relativePath = relativePath;
+    item->report.output = NULL;
+    item->report.format = diff->format;
+    item->report.differentLines = 0;
+    item->error = error;
+    item->isDone = false;
+
+    pthread_mutex_lock(&diff->mutex);
+    diff->pushed++;
+    pthread_cond_signal(&diff->itemQueued);
+    pthread_mutex_unlock(&diff->mutex);
+}
+
+/**
+ * @brief Compares two names for qsort
+ *
+ * @param name1 Pointer to the first name
+ * @param name2 Pointer to the second name
+ * @return The result of strcmp
+ */
+static int compareNames(const void *name1, const void *name2)
+{
+    return strcmp(*(char *const *)name1, *(char *const *)name2);
+}
+
+/**
+ * @brief Reads the names of all entries of the directory (without . and ..) sorted by name
+ *
+ * @param path The path of the directory
+ * @param nameCount Pointer which will be set to the amount of names
+ * @return The allocated array of allocated names or NULL on error (errno is set)
+ */
+static char **readNames(const char *path, size_t *nameCount)
+{
+    DIR *directory = opendir(path);
+    if (directory == NULL)
+        return NULL;
+
+    size_t count = 0, capacity = 16;
+    char **names = malloc(capacity * sizeof(char *));
+    struct dirent *entry;
+
+    while (names != NULL && (errno = 0, entry = readdir(directory)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        if (count == capacity)
+        {
+            char **grown = realloc(names, (capacity *= 2) * sizeof(char *));
+            if (grown == NULL)
+                break;
+            names = grown;
+        }
+
+        if ((names[count] = strdup(entry->d_name)) == NULL)
+            break;
+        count++;
+    }
+
+    int error = (names == NULL || entry != NULL) ? ENOMEM : errno;
+    closedir(directory);
+
+    if (error != 0)
+    {
+        for (size_t i = 0; names != NULL && i < count; i++)
+            free(names[i]);
+        free(names);
+        errno = error;
+        return NULL;
+    }
+
+    qsort(names, count, sizeof(char *), &compareNames);
+    *nameCount = count;
+
+    return names;
+}
+
+/**
+ * @brief Returns true, if the path is a regular file or a symbolic link to a regular file
+ *
+ * @param path The path of the file
+ * @return true if the path is a regular file, otherwise false
+ */
+static bool isRegularFile(const char *path)
+{
+    struct stat status;
+    return stat(path, &status) == 0 && S_ISREG(status.st_mode);
+}
+
+/**
+ * @brief Walks the directory of the first directory-tree recursively in the order of the
+ * paths and queues every regular file, which also exists in the second directory-tree.
+ * A subdirectory, which can't be read, is queued with its error at its place in the order.
+ *
+ * @param diff Pointer to the shared data of the comparison
+ * @param relativeDirectory The relative path of the directory (empty for the root)
+ * @return 0 on success and -1 on error (errno is set)
+ */
+static int walkDirectory(struct treeDiff *diff, const char *relativeDirectory)
+{
+    char *path = joinPath(diff->directory1, relativeDirectory);
+    if (path == NULL)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    size_t nameCount;
+    char **names = readNames(path, &nameCount);
+    free(path);
+    if (names == NULL)
+        return -1;
+
+    int result = 0;
+    for (size_t i = 0; i < nameCount; i++)
+    {
+        char *relativePath = (relativeDirectory[0] == '\0') ? strdup(names[i]) : joinPath(relativeDirectory, names[i]);
+        char *path1 = (relativePath != NULL) ? joinPath(diff->directory1, relativePath) : NULL;
+        char *path2 = (relativePath != NULL) ? joinPath(diff->directory2, relativePath) : NULL;
+        if (path1 == NULL || path2 == NULL)
+        {
+            free(relativePath);
+            free(path1);
+            free(path2);
+            errno = ENOMEM;
+            result = -1;
+            break;
+        }
+
+        // symbolic links to directories are not followed, so that the walk can't loop
+        struct stat status;
+        if (lstat(path1, &status) == 0 && S_ISDIR(status.st_mode))
+        {
+            // only a failed allocation stops the walk, the errors of the subdirectories are reported
+            if ((result = walkDirectory(diff, relativePath)) == -1 && errno != ENOMEM)
+            {
+                pushItem(diff, relativePath, errno);
+                result = 0;
+            }
+            else
+            {
+                free(relativePath);
+            }
+        }
+        else if (isRegularFile(path1) == true && isRegularFile(path2) == true)
+        {
+            pushItem(diff, relativePath, 0);
+        }
+        else
+        {
+            free(relativePath);
+        }
+
+        free(path1);
+        free(path2);
+
+        // stop walking after an error of the whole comparison, because no more reports are written
+        if (result == -1 || diff->error != 0)
+            break;
+    }
+
+    for (size_t i = 0; i < nameCount; i++)
+        free(names[i]);
+    free(names);
+
+    return result;
+}
+
+int64_t compareTrees(const char *directory1, const char *directory2, struct outputSink *outputSink, diffKernel kernel, int threadCount, uint64_t *failedPairs)
+{
+    struct treeDiff diff;
+    diff.directory1 = directory1;
+    diff.directory2 = directory2;
+    diff.format = outputSink->format;
+    diff.kernel = kernel;
+    diff.pushed = 0;
+    diff.taken = 0;
+    diff.written = 0;
+    diff.isClosed = false;
+    diff.outputSink = outputSink;
+    diff.differentLines = 0;
+    diff.failedPairs = 0;
+    diff.error = 0;
+    diff.items = malloc(TREE_QUEUE_SIZE * sizeof(struct treeItem));
+
+    pthread_t *threads = malloc(threadCount * sizeof(pthread_t));
+    if (diff.items == NULL || threads == NULL)
+    {
+        free(diff.items);
+        free(threads);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    pthread_mutex_init(&diff.mutex, NULL);
+    pthread_cond_init(&diff.itemQueued, NULL);
+    pthread_cond_init(&diff.itemDone, NULL);
+
+    int started = 0;
+    while (started < threadCount && pthread_create(&threads[started], NULL, &compareWorker, &diff) == 0)
+        started++;
+
+    if (started == 0)
+        diff.error = EAGAIN;
+    else if (walkDirectory(&diff, "") == -1)
+        diff.error = errno;
+
+    // let the worker-threads finish the queued pairs and write the remaining reports
+    pthread_mutex_lock(&diff.mutex);
+    diff.isClosed = true;
+    pthread_cond_broadcast(&diff.itemQueued);
+    pthread_mutex_unlock(&diff.mutex);
+
+    while (diff.written < diff.pushed)
+        writeItem(&diff);
+
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_cond_destroy(&diff.itemDone);
+    pthread_cond_destroy(&diff.itemQueued);
+    pthread_mutex_destroy(&diff.mutex);
+    free(diff.items);
+    free(threads);
+
+    if (diff.error != 0)
+    {
+        errno = diff.error;
+        return -1;
+    }
+
+    *failedPairs = diff.failedPairs;
+    return diff.differentLines;
+}
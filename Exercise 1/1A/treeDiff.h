@@ -0,0 +1,51 @@
+/**
+ * @file treeDiff.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the comparison of two directory-trees.
+ *
+ * The first directory-tree is walked recursively in the order of the paths
+ * (the entries of every directory are sorted by name). Every regular file,
+ * which exists at the same relative path in the second directory-tree, forms
+ * a pair. The pairs are handed to a pool of worker-threads through a bounded
+ * queue and the reports of the pairs are written in the order of the paths,
+ * so the output doesn't depend on the amount of threads. A pair, which can't
+ * be compared, doesn't stop the comparison, its error is written at its place.
+ */
+
+#ifndef TREEDIFF_H
+#define TREEDIFF_H
+
+#include <stdint.h>
+#include "diffKernel.h"
+#include "outputSink.h"
+
+/**
+ * @brief Maximal amount of pairs, which are queued or whose reports are not written yet
+ */
+#define TREE_QUEUE_SIZE 1024
+
+/**
+ * @brief This function compares all pairs of regular files with the same relative path
+ * in both directory-trees line by line. For every pair a file-header with the relative
+ * path, the differing lines and the message that no differences were found (if the files
+ * don't differ) are written to the output.
+ * @details Files which only exist in one of the directory-trees are skipped. Symbolic links
+ * to regular files are compared, symbolic links to directories are not followed. If a pair
+ * can't be compared (e.g. a file can't be read or vanished) or a subdirectory of the first
+ * directory-tree can't be read, the file-header and the error (see writeFileError) are written
+ * instead of the report and the comparison continues with the next pair.
+ *
+ * @param directory1 The path of the first directory
+ * @param directory2 The path of the second directory
+ * @param outputSink Pointer to the output-sink specified for the output
+ * @param kernel The kernel which counts the differing characters per line
+ * @param threadCount The amount of worker-threads which compare the pairs
+ * @param failedPairs Pointer which will be set to the amount of pairs, which couldn't be compared
+ * @return The amount of different lines of all compared pairs or -1 if the first directory can't
+ * be read, writing the output failed or another error occured (errno is set)
+ */
+int64_t compareTrees(const char *directory1, const char *directory2, struct outputSink *outputSink, diffKernel kernel, int threadCount, uint64_t *failedPairs);
+
+#endif
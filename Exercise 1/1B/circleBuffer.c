@@ -10,15 +10,18 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <stdbool.h>
+#include <sched.h>
 #include <semaphore.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include "circleBuffer.h"
 #include "sharedMemory.h"
 
-struct circleBuffer *openCircleBuffer(bool isServer)
+struct circleBuffer *openCircleBuffer(bool isServer, bool hasGraph)
 {
     struct circleBuffer *circleBuffer = malloc(sizeof(struct circleBuffer));
     if (circleBuffer == NULL)
@@ -27,7 +30,7 @@ struct circleBuffer *openCircleBuffer(bool isServer)
     }
 
     // open sharedmemory
-    circleBuffer->sharedMemory = openSharedMemory(&circleBuffer->shmfd, isServer);
+    circleBuffer->sharedMemory = openSharedMemory(&circleBuffer->shmfd, isServer, hasGraph);
     if (circleBuffer->sharedMemory == NULL)
     {
         free(circleBuffer);
@@ -36,9 +39,8 @@ struct circleBuffer *openCircleBuffer(bool isServer)
 
     circleBuffer->semFreeMemory = NULL;
     circleBuffer->semUsedMemory = NULL;
-    circleBuffer->semIsWriting = NULL;
 
-    circleBuffer->semFreeMemory = (isServer == true) ? sem_open(SEM_NAME_FREESPACE, O_CREAT | O_EXCL, 0600, BUFFER_LENGTH) : sem_open(SEM_NAME_FREESPACE, 0);
+    circleBuffer->semFreeMemory = (isServer == true) ? sem_open(SEM_NAME_FREESPACE, O_CREAT | O_EXCL, 0600, 0) : sem_open(SEM_NAME_FREESPACE, 0);
     if (circleBuffer->semFreeMemory == SEM_FAILED)
     {
         closeSharedMemory(circleBuffer->sharedMemory, &circleBuffer->shmfd, isServer);
@@ -59,23 +61,6 @@ struct circleBuffer *openCircleBuffer(bool isServer)
         return NULL;
     }
 
-    circleBuffer->semIsWriting = (isServer == true) ? sem_open(SEM_NAME_WRITE, O_CREAT | O_EXCL, 0600, 1) : sem_open(SEM_NAME_WRITE, 0);
-    if (circleBuffer->semIsWriting == SEM_FAILED)
-    {
-        sem_close(circleBuffer->semFreeMemory);
-        sem_close(circleBuffer->semUsedMemory);
-        if (isServer == true)
-        {
-            sem_unlink(SEM_NAME_FREESPACE);
-            sem_unlink(SEM_NAME_USEDSPACE);
-        }
-        closeSharedMemory(circleBuffer->sharedMemory, &circleBuffer->shmfd, isServer);
-
-        free(circleBuffer);
-
-        return NULL;
-    }
-
     return circleBuffer;
 }
 
@@ -85,9 +70,9 @@ int closeCircleBuffer(struct circleBuffer *circleBuffer, bool isServer)
 
     if (isServer == true)
     {
-        // to stop all clients from writing to shared memory
+        // to stop all clients from writing to shared memory, a woken writer wakes the next one
+        __atomic_store_n(&circleBuffer->sharedMemory->isAlive, false, __ATOMIC_SEQ_CST);
         sem_post(circleBuffer->semFreeMemory);
-        circleBuffer->sharedMemory->isAlive = false;
     }
 
     if (closeSharedMemory(circleBuffer->sharedMemory, &circleBuffer->shmfd, isServer) == -1)
@@ -99,17 +84,12 @@ int closeCircleBuffer(struct circleBuffer *circleBuffer, bool isServer)
     if (sem_close(circleBuffer->semUsedMemory) == -1)
         returnValue = -1;
 
-    if (sem_close(circleBuffer->semIsWriting) == -1)
-        returnValue = -1;
-
     if (isServer == true)
     {
         if (sem_unlink(SEM_NAME_FREESPACE) == -1)
             returnValue = -1;
         if (sem_unlink(SEM_NAME_USEDSPACE) == -1)
             returnValue = -1;
-        if (sem_unlink(SEM_NAME_WRITE) == -1)
-            returnValue = -1;
     }
 
     free(circleBuffer);
@@ -117,63 +97,172 @@ int closeCircleBuffer(struct circleBuffer *circleBuffer, bool isServer)
     return returnValue;
 }
 
-char *readCircleBuffer(struct circleBuffer *circleBuffer)
+/**
+ * @brief Returns the size of the record with the content of the specified length
+ *
+ * @param length Length of the content in bytes
+ * @return Size of the header and the content, rounded up to RECORD_ALIGNMENT
+ */
+static size_t getRecordSize(size_t length)
+{
+    return RECORD_ALIGNMENT + (length + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+/**
+ * @brief Returns the header of the record at the specified position of the ring
+ *
+ * @param sharedMemory Pointer to the shared memory of the circle-buffer
+ * @param position Position (head or tail) of the record
+ * @return Pointer to the header, the content follows directly after it
+ */
+static uint32_t *getRecord(struct sharedMemory *sharedMemory, uint64_t position)
+{
+    return &sharedMemory->buffer[(position % BUFFER_LENGTH) / RECORD_ALIGNMENT];
+}
+
+/**
+ * @brief Clears the specified amount of bytes from the tail on, moves the tail behind
+ * them and wakes up the writers waiting for free memory
+ * @details Only the reader may call this function. The bytes are cleared, because a
+ * writer relies on RECORD_EMPTY as header of the records it reserves.
+ *
+ * @param circleBuffer A Pointer to the circle-buffer
+ * @param size Amount of bytes, which should be freed
+ */
+static void freeMemory(struct circleBuffer *circleBuffer, size_t size)
 {
-    // allocate memory to read a possible new result from shared memory
-    int i = 0, length = 32;
-    char *result = malloc(sizeof(char) * length);
-    if (result == NULL)
+    struct sharedMemory *sharedMemory = circleBuffer->sharedMemory;
+    uint64_t tail = __atomic_load_n(&sharedMemory->tail, __ATOMIC_RELAXED);
+
+    memset(getRecord(sharedMemory, tail), 0, size);
+    __atomic_store_n(&sharedMemory->tail, tail + size, __ATOMIC_SEQ_CST);
+
+    // wake up one waiting writer, unless a wake-up is pending already (waking all of them
+    // would let them fight for the few freed bytes, the next release wakes the next one)
+    int pending;
+    if (__atomic_load_n(&sharedMemory->waitingWriters, __ATOMIC_SEQ_CST) > 0 && sem_getvalue(circleBuffer->semFreeMemory, &pending) == 0 && pending <= 0)
+        sem_post(circleBuffer->semFreeMemory);
+}
+
+const void *readCircleBuffer(struct circleBuffer *circleBuffer, size_t *length)
+{
+    struct sharedMemory *sharedMemory = circleBuffer->sharedMemory;
+
+    // check if there is something new to read
+    if (sem_wait(circleBuffer->semUsedMemory) == -1)
         return NULL;
 
-    do
+    while (true)
     {
-        // check if there is something new to read
-        if (sem_wait(circleBuffer->semUsedMemory) == -1)
+        uint64_t tail = __atomic_load_n(&sharedMemory->tail, __ATOMIC_RELAXED);
+        uint32_t *record = getRecord(sharedMemory, tail);
+        uint32_t header = __atomic_load_n(record, __ATOMIC_ACQUIRE);
+
+        if (header == RECORD_PADDING)
         {
-            free(result);
-            return NULL;
+            freeMemory(circleBuffer, BUFFER_LENGTH - tail % BUFFER_LENGTH);
         }
-
-        // double the result string if there is not enough memory allocated
-        if (i == length)
+        else if (header == RECORD_EMPTY)
         {
-            length *= 2;
-            result = realloc(result, sizeof(char) * length);
+            // a later record is written already, but the writer of this one is still copying
+            sched_yield();
         }
+        else
+        {
+            *length = header;
+            return record + 1;
+        }
+    }
+}
 
-        // read from shared memory and share that there is new free space available (through semFreeSpace)
-        result[i++] = circleBuffer->sharedMemory->buffer[circleBuffer->sharedMemory->readPos];
-        sem_post(circleBuffer->semFreeMemory);
-        circleBuffer->sharedMemory->readPos += 1;
-        circleBuffer->sharedMemory->readPos %= BUFFER_LENGTH;
-    } while (circleBuffer->sharedMemory->isAlive && result[i - 1] != '\0');
+void releaseCircleBuffer(struct circleBuffer *circleBuffer)
+{
+    struct sharedMemory *sharedMemory = circleBuffer->sharedMemory;
+    uint64_t tail = __atomic_load_n(&sharedMemory->tail, __ATOMIC_RELAXED);
 
-    return result;
+    freeMemory(circleBuffer, getRecordSize(*getRecord(sharedMemory, tail)));
 }
 
-void writeCircleBuffer(struct circleBuffer *circleBuffer, char *content)
+/**
+ * @brief Waits until the reader frees memory, if the specified head still doesn't fit
+ * in the buffer after announcing the waiting writer.
+ * @details The writer is announced before the tail is checked again and the reader moves
+ * the tail before it checks for waiting writers, so no wake-up gets lost.
+ *
+ * @param circleBuffer A Pointer to the circle-buffer
+ * @param head The head after the reservation, which didn't fit in the buffer
+ * @return true if the writer should try to reserve the memory again, false if the waiting
+ * was interrupted or the circle-buffer was closed
+ */
+static bool waitForFreeMemory(struct circleBuffer *circleBuffer, uint64_t head)
 {
-    // check if a generator is already writing to the shared memory
-    if (sem_wait(circleBuffer->semIsWriting) == -1)
+    struct sharedMemory *sharedMemory = circleBuffer->sharedMemory;
+
+    __atomic_add_fetch(&sharedMemory->waitingWriters, 1, __ATOMIC_SEQ_CST);
+
+    int returnValue = 0;
+    bool isWaiting = (int64_t)(head - __atomic_load_n(&sharedMemory->tail, __ATOMIC_SEQ_CST)) > BUFFER_LENGTH;
+    if (isWaiting == true)
+        returnValue = sem_wait(circleBuffer->semFreeMemory);
+
+    __atomic_sub_fetch(&sharedMemory->waitingWriters, 1, __ATOMIC_SEQ_CST);
+
+    if (returnValue == -1)
+        return false;
+
+    if (__atomic_load_n(&sharedMemory->isAlive, __ATOMIC_SEQ_CST) == false)
+    {
+        // pass the wake-up of the closing server on to the next waiting writer
+        if (isWaiting == true)
+            sem_post(circleBuffer->semFreeMemory);
+        return false;
+    }
+
+    return true;
+}
+
+void writeCircleBuffer(struct circleBuffer *circleBuffer, const void *content, size_t length)
+{
+    struct sharedMemory *sharedMemory = circleBuffer->sharedMemory;
+    size_t size = getRecordSize(length);
+    if (length == 0 || size > BUFFER_LENGTH)
         return;
 
-    int i = 0;
-    do
+    uint64_t head, newHead;
+    while (true)
     {
-        // check if there is free space to write to the shared memory
-        if (sem_wait(circleBuffer->semFreeMemory) == -1)
-        {
-            sem_post(circleBuffer->semIsWriting);
+        if (__atomic_load_n(&sharedMemory->isAlive, __ATOMIC_ACQUIRE) == false)
             return;
+
+        // the tail is loaded first, so it can't be ahead of the head
+        uint64_t tail = __atomic_load_n(&sharedMemory->tail, __ATOMIC_ACQUIRE);
+        head = __atomic_load_n(&sharedMemory->head, __ATOMIC_RELAXED);
+
+        // a record is never split, the rest of the buffer is reserved as padding instead
+        uint64_t offset = head % BUFFER_LENGTH;
+        newHead = head + size + ((offset + size > BUFFER_LENGTH) ? BUFFER_LENGTH - offset : 0);
+
+        if (newHead - tail > BUFFER_LENGTH)
+        {
+            if (waitForFreeMemory(circleBuffer, newHead) == false)
+                return;
+        }
+        else if (__atomic_compare_exchange_n(&sharedMemory->head, &head, newHead, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == true)
+        {
+            break;
         }
+    }
 
-        // write to the shared memory and increase the used space in memory (through semUsedSpace)
-        circleBuffer->sharedMemory->buffer[circleBuffer->sharedMemory->writePos] = content[i++];
-        sem_post(circleBuffer->semUsedMemory);
-        circleBuffer->sharedMemory->writePos += 1;
-        circleBuffer->sharedMemory->writePos %= BUFFER_LENGTH;
-    } while (circleBuffer->sharedMemory->isAlive && content[i - 1] != '\0');
+    // the memory between head and newHead belongs to this writer now
+    uint32_t *record = getRecord(sharedMemory, head);
+    if (newHead - head > size)
+    {
+        __atomic_store_n(record, RECORD_PADDING, __ATOMIC_RELEASE);
+        record = getRecord(sharedMemory, 0);
+    }
 
-    // make writing to the shared memory available for others
-    sem_post(circleBuffer->semIsWriting);
+    // write the content and announce the new record to the reader (through semUsedMemory)
+    memcpy(record + 1, content, length);
+    __atomic_store_n(record, (uint32_t)length, __ATOMIC_RELEASE);
+    sem_post(circleBuffer->semUsedMemory);
 }
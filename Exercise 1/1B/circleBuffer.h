@@ -9,7 +9,8 @@
  * concerning the circle-buffer. The functionality includes openening/closing the
  * circle-buffer and reading/writing from the circle-buffer. This functionality
  * in combination with the structure allows the circle-buffer to be implemented
- * as a queue with a fixed size buffer (shared memory).
+ * as a queue with a fixed size buffer (shared memory), which any amount of
+ * writers can write to without locking.
  */
 
 #ifndef CIRCLEBUFFER_H
@@ -17,31 +18,49 @@
 
 #include <semaphore.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "sharedMemory.h"
 
 /**
- * @brief Name of semaphore which controls if there is enough free memory
+ * @brief Name of semaphore which wakes up the writers waiting for free memory
  */
 #define SEM_NAME_FREESPACE "12041500_OSUE_SEM_FREE"
 
 /**
- * @brief Name of semaphore which controls how much memory is used
+ * @brief Name of semaphore which counts the written records
  */
 #define SEM_NAME_USEDSPACE "12041500_OSUE_SEM_USED"
 
 /**
- * @brief Name of semaphore which controls if a process is currently writing to the memory
+ * @brief Alignment of the records in the buffer
  */
-#define SEM_NAME_WRITE "12041500_OSUE_SEM_WRITER"
+#define RECORD_ALIGNMENT sizeof(uint32_t)
+
+/**
+ * @brief Header of a reserved record, whose content is not written yet
+ */
+#define RECORD_EMPTY 0
+
+/**
+ * @brief Header of the padding at the end of the buffer, if a record doesn't fit in there
+ */
+#define RECORD_PADDING UINT32_MAX
 
 /**
  * @brief Datatype of the circle-buffer
+ * @details The buffer of the shared memory contains records, which consist of
+ * a uint32_t header and the content of a message. A writer reserves the space
+ * of a record with a single compare-and-swap of the head, copies the content and
+ * sets the header to the length of the content. Records are never split at the
+ * end of the buffer, the remaining space is reserved with the record and marked
+ * as RECORD_PADDING. The semaphores are only used to block, if the buffer is
+ * empty or full, and not for every byte.
  */
 struct circleBuffer
 {
     sem_t *semFreeMemory;
     sem_t *semUsedMemory;
-    sem_t *semIsWriting;
     int shmfd;
     struct sharedMemory *sharedMemory;
 };
@@ -56,17 +75,20 @@ struct circleBuffer
  * client can connect to it.
  *
  * @param isServer Flag that indicates if the caller is a server (true) or client (false)
+ * @param hasGraph Flag that indicates if the server published a graph (ignored for a client)
  * @return Pointer to a circle-buffer, if the creation or opening was successfull, otherwise
  * NULL
  */
-struct circleBuffer *openCircleBuffer(bool isServer);
+struct circleBuffer *openCircleBuffer(bool isServer, bool hasGraph);
 
 /**
  * @brief This function closes the circle-buffer with it's semaphores and sharedmemory. It
  * closes the circlebuffer, with it's semaphores and shared memory, depending on the role
  * in both cases (server and client) the sharedmemory and the semaphores are getting closed.
- * If the specified role is a server than additionally the semaphore will be unlinked from all clients.
+ * If the specified role is a server than additionally the semaphore will be unlinked from all
+ * clients and the writers waiting for free memory are woken up.
  * @details The circleBuffer should not be used after returning from this call, because
+ * its memory is freed.
  *
  * @param circleBuffer Pointer to the circle-buffer which should be closed
  * @param isServer Flag that indicates if the caller is a server (true) or client (false)
@@ -75,29 +97,43 @@ struct circleBuffer *openCircleBuffer(bool isServer);
 int closeCircleBuffer(struct circleBuffer *circleBuffer, bool isServer);
 
 /**
- * @brief This function reads a null-terminated string from the specified circlebuffer. It first
- * checks if there is any new content to read from and second it releases the used memory. This
- * is done via two semaphores which control those piecse of information
+ * @brief This function reads the next record from the specified circlebuffer. It waits until
+ * a record is written and returns its content in place, without copying it. The memory of the
+ * record is released by releaseCircleBuffer.
  * @details The caller should pass a pointer to a valid circleBuffer and only one server
- * should read from the solution, for correct usage.
+ * should read from the solution, for correct usage. The returned content is only valid until
+ * releaseCircleBuffer is called, which has to happen before the next call of this function.
  *
  * @param circleBuffer A Pointer to the circle-buffer which should be read from
- * @return A String containing the new result read from the shared memory
+ * @param length Pointer which will be set to the length of the content
+ * @return Pointer to the content of the record in the shared memory, or NULL if the waiting
+ * was interrupted (e.g. by a signal)
+ */
+const void *readCircleBuffer(struct circleBuffer *circleBuffer, size_t *length);
+
+/**
+ * @brief This function releases the record returned by the last call of readCircleBuffer,
+ * so that the writers can reuse its memory.
+ * @details The caller should pass a pointer to a valid circleBuffer, which returned a record
+ * by readCircleBuffer, that is not released yet.
+ *
+ * @param circleBuffer A Pointer to the circle-buffer which was read from
  */
-char *readCircleBuffer(struct circleBuffer *circleBuffer);
+void releaseCircleBuffer(struct circleBuffer *circleBuffer);
 
 /**
- * @brief This function writes to the specified circlebuffer. First it checks if another process
- * is already writing to it. In this case the functions terminates and just returns. Second, if
- * no process is already writing, it checks if there is memory free to write. If yes it writes
- * the content to the shared memory, otherwise it just terminates and returns. Those checks are
- * done via semaphores, which keep track about those pieces of information.
+ * @brief This function writes the content as one record to the specified circlebuffer. It
+ * reserves the memory for the record, copies the content and announces the new record (through
+ * semUsedMemory). Any amount of processes can write at the same time. If there is not enough
+ * free memory, it waits until the reader releases records, or the circle-buffer is closed by
+ * the server (then nothing is written).
  * @details The caller should pass a pointer to a valid circleBuffer and content != NULL to the
- * function to work properly.
+ * function to work properly. Content, which is empty or doesn't fit in the buffer, is not written.
  *
  * @param circleBuffer A Pointer to the circle-buffer which should be written to
- * @param content The content as a char array (zero terminated) which should be written to the circle-buffer
+ * @param content Pointer to the content which should be written to the circle-buffer
+ * @param length Length of the content in bytes
  */
-void writeCircleBuffer(struct circleBuffer *circleBuffer, char *content);
+void writeCircleBuffer(struct circleBuffer *circleBuffer, const void *content, size_t length);
 
 #endif
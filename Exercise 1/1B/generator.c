@@ -7,6 +7,15 @@
  *
  * This generator programm calculates possible solution for the 3coloring problem
  * for the given graph. It reports it's solution to the circle-buffer.
+ * The programm takes the edges as arguments and the following options:
+ * [-t threads], the amount of solver threads, which share the graph and the
+ * circle-buffer, 1 by default.
+ * [-f file], a file with more edges (separated by whitespace), - reads stdin.
+ * [-s strategy], random (default) colors the vertices randomly again and again,
+ * local recolors single vertices of a coloring with a min-conflicts local search.
+ * Without edges the generator attaches to the graph, which the supervisor has
+ * published in the shared memory, so it doesn't have to parse it again (this
+ * fails, if the supervisor didn't get a graph).
  */
 #include <stdlib.h>
 #include <stdbool.h>
@@ -14,37 +23,60 @@
 #include <signal.h>
 #include <string.h>
 #include <errno.h>
-#include <regex.h>
 #include <assert.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <sys/types.h>
 #include "circleBuffer.h"
+#include "graph.h"
+#include "randomGenerator.h"
+#include "slicedColoring.h"
+#include "localSearch.h"
 
 /**
- * @brief Definies the max length a solution can have
- *
+ * @brief Maximal amount of solver threads
+ */
+#define MAX_THREAD_COUNT 1024
+
+/**
+ * @brief Strategies of the solvers
+ * @details STRATEGY_RANDOM: random colorings (see solveProblem)
+ * STRATEGY_LOCAL: min-conflicts local search (see searchLocally)
  */
-#define MAX_SOLUTION_LENGTH 8
+enum strategy
+{
+    STRATEGY_RANDOM,
+    STRATEGY_LOCAL
+};
 
 /**
- * @brief Data structure to store an edge
- * @details Because the graph is undirected, this information is not necessary
- * and therefore it isn't important which vertex is the start or the end.
+ * @brief Data structure to store the options of the programm
  */
-struct Edge
+struct options
 {
-    struct Vertex *vertex1;
-    struct Vertex *vertex2;
+    int threadCount;
+    char *graphFileName;
+    enum strategy strategy;
 };
 
 /**
- * @brief Data structure to store a vertex
- * @details Color: Green (0), Blue (1), Red (2), Undefined (-1)
+ * @brief Data structure to store a solver thread
+ * @details All solvers share the graph and the circle-buffer. Every solver has its own
+ * color planes of LANE_COUNT colorings (two per vertex index, see fillRandomColorPlanes,
+ * with the colors Green (0), Blue (1), Red (2)) or its own local search, depending on the
+ * strategy, and the state of its random number generator. The best solution so far is
+ * shared by all generators.
  */
-struct Vertex
+struct solver
 {
-    char *name;
-    int color;
+    pthread_t thread;
+    struct circleBuffer *circleBuffer;
+    const struct graph *graph;
+    enum strategy strategy;
+    uint64_t *colorPlanes;
+    struct localSearch localSearch;
+    struct randomGenerator randomGenerator;
 };
 
 static char *progName; /** name of the programm */
@@ -64,50 +96,81 @@ static volatile sig_atomic_t quit = 0;
 static void handle_signal(int signal) { quit = 1; }
 
 /**
- * @brief The function parses the arguments to vertices and edges. It terminates the
- * programm if a argument does not meet the format for a vertex (number-number). Otherwise
- * it saves the new vertices and edges inside the arrays and increases the total-sizes of
- * the arrays.
- * @details Exits with code EXIT_FAILURE when a argument does not match the rule for edges
+ * @brief This functions prints the usage-Message to stderr und exits the programm with code EXIT_FAILURE.
+ * @details global variables: progName
+ */
+static void printUsageInfoAndExit(void);
+
+/**
+ * @brief The function parses the options of the programm.
+ * @details If the user provides wrong options the programm terminates with return-value
+ * EXIT_FAILURE and prints the usage-Message
+ *
+ * @param argc Number of arguments provided
+ * @param argv Values of arguments provided
+ * @param options Pointer to the options, where the specified options are saved to
+ */
+static void parseOptions(int argc, char **argv, struct options *options);
+
+/**
+ * @brief The function reads the edges of the graph file (if specified) and parses the
+ * arguments to vertices and edges. It terminates the programm if a argument does not meet
+ * the format for an edge (number-number). Otherwise it adds the edge and its vertices to
+ * the graph.
+ * @details Exits with code EXIT_FAILURE when a argument does not match the rule for edges,
+ * or the graph file can't be read. The edges start at the first argument, which is no
+ * option (optind).
  *
  * @param argc Number of arguments provided
  * @param argv Values of arguments provided
- * @param vertices Pointer to the array of vertex-pointers, where the vertices are saved to
- * @param totalSizeVertices Size of the array vertices
- * @param edges Pointer to the array of edge-pointers, where the edges are saved to
- * @param totalSizeEdges Size of the array edges
+ * @param graphFileName The filename/path of the graph file, - for stdin, or NULL
+ * @param graph Pointer to the initialized graph, where the vertices and edges are saved to
  */
-static void parseArgumentsToGraph(int argc, char **argv, struct Vertex ***vertices, int *totalSizeVertices, struct Edge ***edges, int *totalSizeEdges);
+static void parseArgumentsToGraph(int argc, char **argv, char *graphFileName, struct graph *graph);
 
 /**
  * @brief This functions solves the 3coloring problem for the given graph. First this function
- * colors the edges randomly with colors. Then it removes the edges with same colored vertices.
- * Then it reports this solution to the circle-buffer and therefore to the supervisor. This
- * process repeats itself until the circle-buffer is closed, or the graph is 3colorable by itself.
- * @details Caller should check that length from **vertices fits together with totalSizeVertices
- * and the length from edges fits together with totalSizeEdges, otherwise function works not properly
- * or segmentation fault could happen. Also the caller is responsible for a valid circleBuffer-object
- * or unexpected behaviour could happen.
+ * colors the vertices randomly in LANE_COUNT colorings at once. Then it removes the edges with
+ * same colored vertices of the coloring with the fewest of them. Then it reports this solution as
+ * a binary record to the circle-buffer and therefore to the supervisor, if it is better than every
+ * solution reported so far (by any generator). The edges are only scanned until no coloring can be
+ * better anymore. This process repeats itself until the circle-buffer is closed, the process is
+ * stopped by a signal, or the graph is 3colorable by itself.
+ * @details The caller is responsible for a valid graph and circleBuffer-object and for color planes,
+ * which have room for every vertex, or unexpected behaviour could happen. Several solvers can run
+ * at the same time.
+ * global variables: quit
+ *
+ * @param solver Pointer to the solver, which contains the graph, the circle-buffer, the color
+ * planes and the state of the random number generator
+ */
+static void solveProblem(struct solver *solver);
+
+/**
+ * @brief This functions solves the 3coloring problem for the given graph with a min-conflicts
+ * local search (see localSearch.h). Every time the coloring has less edges with same colored
+ * vertices than every solution reported so far (by any generator), it reports them as a binary
+ * record to the circle-buffer and therefore to the supervisor. The search is restarted with a
+ * random coloring, when it is stuck. This process repeats itself until the circle-buffer is
+ * closed, the process is stopped by a signal, or the graph is 3colorable by itself.
+ * @details The caller is responsible for a valid graph and circleBuffer-object and for an
+ * initialized local search, or unexpected behaviour could happen. Several solvers can run
+ * at the same time.
+ * global variables: quit
  *
- * @param circleBuffer Pointer to the circle-buffer
- * @param vertices Pointer to the array of vertex-pointers of the graph
- * @param totalSizeVertices Size of the array vertices
- * @param edges Pointer to the array of edge-pointers of the graph
- * @param totalSizeEdges Size of the array edges
+ * @param solver Pointer to the solver, which contains the graph, the circle-buffer, the local
+ * search and the state of the random number generator
  */
-static void solveProblem(struct circleBuffer *circleBuffer, struct Vertex **vertices, int totalSizeVertices, struct Edge **edges, int totalSizeEdges);
+static void searchLocally(struct solver *solver);
 
 /**
- * @brief Frees all the allocated Memory from the graph
- * @details Vertices and edges are not usable after the call returns. If used
- * segmentation fault will happen.
+ * @brief Entry point of a solver thread, which calls solveProblem or searchLocally, depending
+ * on the strategy of the solver
  *
- * @param vertices Pointer to the array of vertex-pointers of the graph
- * @param totalSizeVertices Size of the array @param vertices
- * @param edges Pointer to the array of edge-pointers of the graph
- * @param totalSizeEdges Size of the array @param edges
+ * @param argument Pointer to the solver of the thread
+ * @return NULL
  */
-static void freeGraph(struct Vertex **vertices, int totalSizeVertices, struct Edge **edges, int totalSizeEdges);
+static void *runSolver(void *argument);
 
 /**
  * @brief This functions prints the errorMessage to stderr and exits the programm with code EXIT_FAILURE.
@@ -117,6 +180,14 @@ static void freeGraph(struct Vertex **vertices, int totalSizeVertices, struct Ed
  */
 static void printErrorAndExit(char *errorMessage);
 
+/**
+ * @brief This function frees the solvers and their local searches.
+ *
+ * @param solvers Pointer to the solvers (or NULL)
+ * @param threadCount Amount of solvers
+ */
+static void freeSolvers(struct solver *solvers, int threadCount);
+
 /**
  * generators entry point
  * @brief This function parses the arguments, opens/closes the circle-buffer
@@ -129,8 +200,7 @@ static void printErrorAndExit(char *errorMessage);
  */
 int main(int argc, char *argv[])
 {
-    // set random
-    srand(getpid());
+    progName = argv[0];
 
     // Setup the singal handler
     struct sigaction sa;
@@ -139,28 +209,106 @@ int main(int argc, char *argv[])
     sigaction(SIGINT, &sa, NULL);
     sigaction(SIGTERM, &sa, NULL);
 
-    // set up pointers for vertices and edges
-    struct Vertex **vertices = NULL;
-    struct Edge **edges = NULL;
-    int totalSizeVertices = 0, totalSizeEdges = 0;
+    struct graph graph;
+    initGraph(&graph);
 
-    // parse arguments to edges and vertices
-    parseArgumentsToGraph(argc, argv, &vertices, &totalSizeVertices, &edges, &totalSizeEdges);
+    // parse options and arguments to edges and vertices
+    struct options options = {.threadCount = 1, .graphFileName = NULL, .strategy = STRATEGY_RANDOM};
+    parseOptions(argc, argv, &options);
+    parseArgumentsToGraph(argc, argv, options.graphFileName, &graph);
+    int threadCount = options.threadCount;
 
     // open the circle-buffer
-    struct circleBuffer *circleBuffer = openCircleBuffer(false);
+    struct circleBuffer *circleBuffer = openCircleBuffer(false, false);
     if (circleBuffer == NULL)
     {
-        // free vertices
-        freeGraph(vertices, totalSizeVertices, edges, totalSizeEdges);
+        freeGraph(&graph);
         printErrorAndExit("Opening circle-buffer failed");
     }
 
-    // solve 3coloring problem
-    solveProblem(circleBuffer, vertices, totalSizeVertices, edges, totalSizeEdges);
+    // only the graph of the running supervisor is attached, a crashed supervisor could have left its image behind
+    bool isAttaching = options.graphFileName == NULL && optind == argc;
+    if (isAttaching == true && circleBuffer->sharedMemory->hasGraph == false)
+    {
+        fprintf(stderr, "[%s] ERROR: The supervisor has no graph, the edges have to be specified\n", progName);
+        closeCircleBuffer(circleBuffer, false);
+        exit(EXIT_FAILURE);
+    }
+
+    // attach to the graph of the supervisor, which is complete when the circle-buffer exists
+    if (isAttaching == true && attachGraph(&graph, SHM_GRAPH_NAME) == -1)
+    {
+        int error = errno;
+        closeCircleBuffer(circleBuffer, false);
+        errno = error;
+        printErrorAndExit("Attaching to the graph of the supervisor failed");
+    }
+
+    // set up the solvers, every solver has its own color planes (on its own cache lines) or local search and random numbers
+    size_t planesPerLine = CACHE_LINE_SIZE / sizeof(uint64_t);
+    size_t planesSize = (2 * (size_t)graph.vertexCount / planesPerLine + 1) * planesPerLine;
+    struct solver *solvers = calloc(threadCount, sizeof(struct solver));
+    uint64_t *colorPlanes = NULL;
+    bool isAllocated = (solvers != NULL);
 
-    // free vertices
-    freeGraph(vertices, totalSizeVertices, edges, totalSizeEdges);
+    if (isAllocated == true && options.strategy == STRATEGY_RANDOM)
+    {
+        colorPlanes = malloc(planesSize * threadCount * sizeof(uint64_t));
+        isAllocated = (colorPlanes != NULL);
+    }
+    else if (isAllocated == true)
+    {
+        // the local search recolors vertices over their neighbours
+        isAllocated = (buildAdjacency(&graph) == 0);
+        for (int i = 0; i < threadCount && isAllocated == true; i++)
+            isAllocated = (initLocalSearch(&solvers[i].localSearch, &graph) == 0);
+    }
+
+    if (isAllocated == false)
+    {
+        freeSolvers(solvers, threadCount);
+        free(colorPlanes);
+        freeGraph(&graph);
+        closeCircleBuffer(circleBuffer, false);
+        printErrorAndExit("Allocation of memory for the solvers failed");
+    }
+
+    // solve 3coloring problem with all solvers
+    int startedThreads = 0, result = 0;
+    for (; startedThreads < threadCount && result == 0; startedThreads++)
+    {
+        struct solver *solver = &solvers[startedThreads];
+        solver->circleBuffer = circleBuffer;
+        solver->graph = &graph;
+        solver->strategy = options.strategy;
+        if (colorPlanes != NULL)
+            solver->colorPlanes = &colorPlanes[startedThreads * planesSize];
+        seedRandomGenerator(&solver->randomGenerator, (uint64_t)getpid() << 32 | startedThreads);
+
+        result = pthread_create(&solver->thread, NULL, runSolver, solver);
+    }
+
+    // stop the started solvers, if a thread could not be created
+    if (result != 0)
+    {
+        quit = 1;
+        startedThreads--;
+    }
+
+    for (int i = 0; i < startedThreads; i++)
+        pthread_join(solvers[i].thread, NULL);
+
+    // free solvers and graph
+    freeSolvers(solvers, threadCount);
+    free(colorPlanes);
+    freeGraph(&graph);
+
+    if (result != 0)
+    {
+        closeCircleBuffer(circleBuffer, false);
+        errno = result;
+        printErrorAndExit("Creating a solver thread failed");
+    }
 
     // close cirle-buffer
     if (closeCircleBuffer(circleBuffer, false) == -1)
@@ -175,247 +323,161 @@ static void printErrorAndExit(char *errorMessage)
     exit(EXIT_FAILURE);
 }
 
-static void freeGraph(struct Vertex **vertices, int totalSizeVertices, struct Edge **edges, int totalSizeEdges)
+static void printUsageInfoAndExit(void)
 {
-    // free vertices
-    for (int i = 0; i < totalSizeVertices; i++)
-        free(vertices[i]);
-
-    free(vertices);
-
-    // free edges
-    for (int i = 0; i < totalSizeEdges; i++)
-        free(edges[i]);
-
-    free(edges);
+    fprintf(stderr, "Usage: %s [-t threads] [-f file] [-s random|local] [Edge Edge Edge ...]\n", progName);
+    fprintf(stderr, "Example: %s 0-1 0-2 1-2\n", progName);
+    exit(EXIT_FAILURE);
 }
 
-/**
- * @brief Returns the Vertex with the specified name out of the vertices array
- * @details Caller should check that length from **vertices fits together with totalSizeVertices
- * otherwise function works not properly or segmentation fault could happen.
- *
- * @param vertices Array of pointers to vertices
- * @param name Name of vertex to search for
- * @param totalSizeVertices Length of the array
- * @return Pointer to Vertex with the specified name, or NULL if not found
- */
-static struct Vertex *getVertex(struct Vertex **vertices, char *name, int totalSizeVertices)
+static void parseOptions(int argc, char **argv, struct options *options)
 {
-    for (int i = 0; i < totalSizeVertices; i++)
-    {
-        if (strcmp(vertices[i]->name, name) == 0)
-            return vertices[i];
-    }
-
-    return NULL;
-}
+    char *end;
+    long number;
 
-/**
- * @brief Returns the Edge with the specified vertices out of the edges array, Because
- * the graph is undirected, it returns the first edge which contains both vertices, where
- * the ordering is ignored. Therefore 0-1 or 1-0 is returned if those are the vertices specified.
- * @details Caller should check that length from **edges fits together with totalSizeEdges
- * otherwise function works not properly or segmentation fault could happen and that both
- * vertices are not null.
- *
- * @param edges Array of pointers to edges
- * @param vertex1 One vertex of the edge
- * @param vertex2 The other vertex of the edge
- * @param totalSizeEdges Length of the array
- * @return Pointer to the edge which contains both vertices, or NULL if not found
- */
-static struct Edge *getEdge(struct Edge **edges, struct Vertex *vertex1, struct Vertex *vertex2, int totalSizeEdges)
-{
-    for (int i = 0; i < totalSizeEdges; i++)
+    int opt;
+    while ((opt = getopt(argc, argv, "t:f:s:")) != -1)
     {
-        if (strcmp(edges[i]->vertex1->name, vertex1->name) == 0 && strcmp(edges[i]->vertex2->name, vertex2->name) == 0)
-            return edges[i];
-
-        if (strcmp(edges[i]->vertex1->name, vertex2->name) == 0 && strcmp(edges[i]->vertex2->name, vertex1->name) == 0)
-            return edges[i];
+        switch (opt)
+        {
+        case 't':
+            errno = 0;
+            number = strtol(optarg, &end, 10);
+            if (errno != 0 || end == optarg || *end != '\0' || number < 1 || number > MAX_THREAD_COUNT)
+                printUsageInfoAndExit();
+            options->threadCount = number;
+            break;
+        case 'f':
+            if (options->graphFileName != NULL)
+                printUsageInfoAndExit();
+            options->graphFileName = optarg;
+            break;
+        case 's':
+            if (strcmp(optarg, "random") == 0)
+                options->strategy = STRATEGY_RANDOM;
+            else if (strcmp(optarg, "local") == 0)
+                options->strategy = STRATEGY_LOCAL;
+            else
+                printUsageInfoAndExit();
+            break;
+        default:
+            printUsageInfoAndExit();
+        }
     }
-
-    return NULL;
 }
 
-/**
- * @brief This functions tries to add a vertex to the provided array. First this functions checks
- * if the vertex already exits. If yes it just returns it, otherwise it adds it to the array and
- * increases the array (reallocates memory) and the totalSizeVertices
- * @details Caller should check that length from **vertices fits together with totalSizeVertices
- * otherwise function works not properly or segmentation fault could happen.
- *
- * @param name Name of the new Vertex
- * @param vertices Pointer to array of vertex-pointers, (reallocates if vertex is added)
- * @param totalSizeVertices Pointer to the size of the array, (increments if vertex is added)
- * @return A pointer to the newly created or found vertex
- */
-static struct Vertex *addVertex(char *name, struct Vertex ***vertices, int *totalSizeVertices)
+static void parseArgumentsToGraph(int argc, char **argv, char *graphFileName, struct graph *graph)
 {
-    struct Vertex *vertex = getVertex(*vertices, name, *totalSizeVertices);
-
-    if ((struct Vertex *)vertex == NULL)
+    // read the graph file
+    if (graphFileName != NULL)
     {
-        if (*vertices == NULL)
-            *vertices = malloc((*totalSizeVertices + 1) * sizeof(struct Vertex *));
-        else
-            *vertices = realloc(*vertices, (*totalSizeVertices + 1) * sizeof(struct Vertex *));
+        FILE *file = (strcmp(graphFileName, "-") == 0) ? stdin : fopen(graphFileName, "r");
+        if (file == NULL)
+            printErrorAndExit("Opening the graph file failed");
 
-        // increase to have the right amount of memory allocated, if successful
-        if (*vertices != NULL)
-            *totalSizeVertices += 1;
+        int returnValue = readGraph(graph, file);
+        if (file != stdin)
+            fclose(file);
 
-        vertex = malloc(sizeof(struct Vertex));
-        // return null and exit if allocation failed
-        if (*vertices == NULL || vertex == NULL)
-            return NULL;
-
-        vertex->name = name;
-        (*vertices)[*totalSizeVertices - 1] = vertex;
+        if (returnValue == -1)
+        {
+            int error = errno;
+            freeGraph(graph);
+            errno = error;
+            printErrorAndExit("Reading the graph file failed");
+        }
     }
 
-    return vertex;
-}
-
-static void parseArgumentsToGraph(int argc, char **argv, struct Vertex ***vertices, int *totalSizeVertices, struct Edge ***edges, int *totalSizeEdges)
-{
-    // create regexp for arguments
-    regex_t regex;
-    if (regcomp(&regex, "^[0-9]+-[0-9]+$", REG_EXTENDED) != 0)
-        printErrorAndExit("Compilation of regexp failed");
-
     // parse vertices and edges
-    for (int i = 1; i < argc; i++)
+    for (int i = optind; i < argc; i++)
     {
-        if (regexec(&regex, argv[i], 0, NULL, 0) == REG_NOMATCH)
+        if (addEdgeText(graph, argv[i]) == -1)
         {
-            regfree(&regex);
-            freeGraph(*vertices, *totalSizeVertices, *edges, *totalSizeEdges);
+            int error = errno;
+            freeGraph(graph);
+            if (error == EINVAL)
+                printUsageInfoAndExit();
 
-            fprintf(stderr, "Usage: %s Edge Edge Edge ... \n", argv[0]);
-            fprintf(stderr, "Example: %s 0-1 0-2 1-2\n", argv[0]);
-            exit(EXIT_FAILURE);
+            errno = error;
+            printErrorAndExit("Allocation of memory for the graph failed");
         }
+    }
+}
 
-        char *vertexName1 = strtok(argv[i], "-");
-        char *vertexName2 = strtok(NULL, " ");
-
-        struct Vertex *vertex1 = addVertex(vertexName1, vertices, totalSizeVertices);
-        struct Vertex *vertex2 = addVertex(vertexName2, vertices, totalSizeVertices);
-        // exit if allocation failed
-        if (vertex1 == NULL || vertex2 == NULL)
-        {
-            regfree(&regex);
-            freeGraph(*vertices, *totalSizeVertices, *edges, *totalSizeEdges);
-            printErrorAndExit("Allocation of memory for a vertex failed");
-        }
-
-        struct Edge *newEdge = getEdge(*edges, vertex1, vertex2, *totalSizeEdges);
-        if ((struct Vertex *)newEdge == NULL)
-        {
-            if (*edges == NULL)
-                *edges = malloc((*totalSizeEdges + 1) * sizeof(struct Edge *));
-            else
-                *edges = realloc(*edges, (*totalSizeEdges + 1) * sizeof(struct Edge *));
-
-            if (*edges != NULL)
-                *totalSizeEdges += 1;
-
-            newEdge = malloc(sizeof(struct Edge));
+static void freeSolvers(struct solver *solvers, int threadCount)
+{
+    if (solvers == NULL)
+        return;
 
-            // exit if allocation failed
-            if (*edges == NULL || newEdge == NULL)
-            {
-                regfree(&regex);
-                freeGraph(*vertices, *totalSizeVertices, *edges, *totalSizeEdges);
-                printErrorAndExit("Allocation of memory for a edge failed");
-            }
+    for (int i = 0; i < threadCount; i++)
+        freeLocalSearch(&solvers[i].localSearch);
+    free(solvers);
+}
 
-            newEdge->vertex1 = vertex1;
-            newEdge->vertex2 = vertex2;
+static void *runSolver(void *argument)
+{
+    struct solver *solver = argument;
 
-            (*edges)[*totalSizeEdges - 1] = newEdge;
-        }
-    }
+    if (solver->strategy == STRATEGY_LOCAL)
+        searchLocally(solver);
+    else
+        solveProblem(solver);
 
-    // free regexp
-    regfree(&regex);
+    return NULL;
 }
 
-/**
- * @brief Convertes the solution and number of edgesRemoved to a null terminated string
- * @details Caller should check that length from **solution fits together with edgesRemoved
- * otherwise function works not properly or segmentation fault could happen.
- *
- * @param solution Array of edges, which should be converted
- * @param edgesRemoved number of edges, which are specified in the @param solution array
- * @return null-terminated string which has the format "edgesRemoved Edge Edge Edge ...""
- */
-static char *generateOutput(struct Edge **solution, int edgesRemoved)
+static void solveProblem(struct solver *solver)
 {
-    // calculate the length of the output string
-    int len = 2;
-    for (int i = 0; i < edgesRemoved; i++)
+    const struct graph *graph = solver->graph;
+    uint64_t *colorPlanes = solver->colorPlanes;
+    struct sharedMemory *sharedMemory = solver->circleBuffer->sharedMemory;
+    struct randomGenerator randomGenerator = solver->randomGenerator;
+    uint32_t smallestSolution;
+
+    // the best solution of all generators is the bound, a solution without edges can't be beaten
+    while (__atomic_load_n(&sharedMemory->isAlive, __ATOMIC_RELAXED) && quit == 0 && (smallestSolution = __atomic_load_n(&sharedMemory->bestSoFar, __ATOMIC_RELAXED)) > 0)
     {
-        len += strlen(solution[i]->vertex1->name);
-        len += strlen(solution[i]->vertex2->name);
-        len += 2;
-    }
+        // color vertices randomly in all lanes
+        fillRandomColorPlanes(&randomGenerator, colorPlanes, graph->vertexCount);
 
-    // Creeate the output string and fill it
-    char *output = malloc(sizeof(char) * len);
-    memset(output, 0, len);
+        // find the coloring with the fewest edges with same colored vertices
+        uint32_t edgesRemoved;
+        int lane = findBestLane(graph, colorPlanes, smallestSolution, &edgesRemoved);
 
-    output[0] = edgesRemoved + '0';
-    output[1] = (edgesRemoved == 0) ? '\0' : ' ';
-    for (int i = 0; i < edgesRemoved; i++)
-    {
-        strcat(output, solution[i]->vertex1->name);
-        strcat(output, "-");
-        strcat(output, solution[i]->vertex2->name);
-        if (i == edgesRemoved - 1)
-            strcat(output, "\0");
-        else
-            strcat(output, " ");
+        if (lane != -1 && lowerBestSoFar(sharedMemory, edgesRemoved) == true)
+        {
+            // write new smallest solution to the buffer
+            struct solution solution;
+            solution.edgeCount = collectLaneConflicts(graph, colorPlanes, lane, solution.vertices, edgesRemoved);
+            writeCircleBuffer(solver->circleBuffer, &solution, SOLUTION_SIZE(solution.edgeCount));
+        }
     }
-
-    return output;
 }
 
-static void solveProblem(struct circleBuffer *circleBuffer, struct Vertex **vertices, int totalSizeVertices, struct Edge **edges, int totalSizeEdges)
+static void searchLocally(struct solver *solver)
 {
-    int smallestSolution = MAX_SOLUTION_LENGTH;
-
-    while (circleBuffer->sharedMemory->isAlive && smallestSolution >= 0 && quit == 0)
-    {
-        // color vertices randomly
-        for (int i = 0; i < totalSizeVertices; i++)
-        {
-            vertices[i]->color = rand() % 3;
-        }
+    struct localSearch *localSearch = &solver->localSearch;
+    struct sharedMemory *sharedMemory = solver->circleBuffer->sharedMemory;
+    struct randomGenerator randomGenerator = solver->randomGenerator;
+    uint32_t smallestSolution;
 
-        struct Edge *solution[MAX_SOLUTION_LENGTH];
-        int edgesRemoved = 0;
+    restartLocalSearch(localSearch, &randomGenerator);
 
-        // remove edges with same colored vertex
-        for (int i = 0; i < totalSizeEdges && edgesRemoved < smallestSolution; i++)
-        {
-            if (edges[i]->vertex1->color == edges[i]->vertex2->color)
-            {
-                solution[edgesRemoved] = edges[i];
-                edgesRemoved++;
-            }
-        }
-
-        if (edgesRemoved < smallestSolution)
+    // the best solution of all generators is the bound, a solution without edges can't be beaten
+    while (__atomic_load_n(&sharedMemory->isAlive, __ATOMIC_RELAXED) && quit == 0 && (smallestSolution = __atomic_load_n(&sharedMemory->bestSoFar, __ATOMIC_RELAXED)) > 0)
+    {
+        uint32_t edgesRemoved = localSearch->conflictEdgeCount;
+        if (edgesRemoved < smallestSolution && lowerBestSoFar(sharedMemory, edgesRemoved) == true)
         {
             // write new smallest solution to the buffer
-            smallestSolution = edgesRemoved;
-            char *output = generateOutput(solution, edgesRemoved);
-            writeCircleBuffer(circleBuffer, output);
-
-            free(output);
+            struct solution solution;
+            solution.edgeCount = collectConflicts(localSearch, solution.vertices, edgesRemoved);
+            writeCircleBuffer(solver->circleBuffer, &solution, SOLUTION_SIZE(solution.edgeCount));
         }
+
+        if (isLocalSearchStuck(localSearch) == true)
+            restartLocalSearch(localSearch, &randomGenerator);
+        else
+            stepLocalSearch(localSearch, &randomGenerator);
     }
 }
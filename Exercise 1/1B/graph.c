@@ -0,0 +1,503 @@
+/**
+ * @file graph.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to add edges to the graph,
+ * to parse and read edges, to build its adjacency, to publish and attach
+ * to its image and to free it.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "graph.h"
+
+/**
+ * @brief Initial capacity of the arrays of the graph
+ */
+#define INITIAL_CAPACITY 16
+
+/**
+ * @brief Initial size of the hash tables of the graph (a power of two)
+ */
+#define INITIAL_TABLE_SIZE 64
+
+/**
+ * @brief Data structure to store the state of the parsing of an edge in text form
+ * @details part is 0 while the first number is parsed and 1 after the '-'.
+ */
+struct edgeParser
+{
+    uint64_t ids[2];
+    int part;
+    bool hasDigits;
+    bool isInEdge;
+};
+
+void initGraph(struct graph *graph)
+{
+    memset(graph, 0, sizeof(*graph));
+}
+
+/**
+ * @brief Grows the arrays to the double capacity, if they are full
+ *
+ * @param arrays Pointers to the arrays, which have the same capacity
+ * @param arrayCount Amount of arrays
+ * @param size Amount of used elements
+ * @param capacity Pointer to the capacity of the arrays, which is updated
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+static int growArrays(uint32_t **arrays[], int arrayCount, size_t size, size_t *capacity)
+{
+    if (size < *capacity)
+        return 0;
+
+    size_t newCapacity = (*capacity == 0) ? INITIAL_CAPACITY : *capacity * 2;
+    for (int i = 0; i < arrayCount; i++)
+    {
+        uint32_t *array = realloc(*arrays[i], sizeof(uint32_t) * newCapacity);
+        if (array == NULL)
+            return -1;
+
+        *arrays[i] = array;
+    }
+
+    *capacity = newCapacity;
+    return 0;
+}
+
+/**
+ * @brief Returns the slot of the hash value in a hash table of the specified size
+ *
+ * @param hash The hash value, the upper bits are mixed best
+ * @param tableSize The size of the table (a power of two)
+ * @return The first slot, which should be probed
+ */
+static size_t getSlot(uint64_t hash, size_t tableSize)
+{
+    return (hash >> 32) & (tableSize - 1);
+}
+
+/**
+ * @brief Returns the hash value of a vertex id
+ *
+ * @param id The id of the vertex
+ * @return The hash value
+ */
+static uint64_t hashVertex(uint32_t id)
+{
+    return (id + UINT64_C(1)) * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/**
+ * @brief Returns the hash value of an edge key
+ *
+ * @param key The key of the edge
+ * @return The hash value
+ */
+static uint64_t hashEdge(uint64_t key)
+{
+    key ^= key >> 31;
+    return key * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+/**
+ * @brief Doubles the size of the vertex table, if adding a vertex would fill more than
+ * half of it, and inserts all vertices again
+ *
+ * @param graph Pointer to the graph
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+static int growVertexTable(struct graph *graph)
+{
+    if (((size_t)graph->vertexCount + 1) * 2 <= graph->vertexTableSize)
+        return 0;
+
+    size_t tableSize = (graph->vertexTableSize == 0) ? INITIAL_TABLE_SIZE : graph->vertexTableSize * 2;
+    uint32_t *table = calloc(tableSize, sizeof(uint32_t));
+    if (table == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i < graph->vertexCount; i++)
+    {
+        size_t slot = getSlot(hashVertex(graph->vertexIds[i]), tableSize);
+        while (table[slot] != 0)
+            slot = (slot + 1) & (tableSize - 1);
+
+        table[slot] = i + 1;
+    }
+
+    free(graph->vertexTable);
+    graph->vertexTable = table;
+    graph->vertexTableSize = tableSize;
+    return 0;
+}
+
+/**
+ * @brief Doubles the size of the edge table, if adding an edge would fill more than
+ * half of it, and inserts all edges again
+ *
+ * @param graph Pointer to the graph
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+static int growEdgeTable(struct graph *graph)
+{
+    if (((size_t)graph->edgeCount + 1) * 2 <= graph->edgeTableSize)
+        return 0;
+
+    size_t tableSize = (graph->edgeTableSize == 0) ? INITIAL_TABLE_SIZE : graph->edgeTableSize * 2;
+    uint64_t *table = calloc(tableSize, sizeof(uint64_t));
+    if (table == NULL)
+        return -1;
+
+    for (size_t i = 0; i < graph->edgeTableSize; i++)
+    {
+        if (graph->edgeTable[i] == 0)
+            continue;
+
+        size_t slot = getSlot(hashEdge(graph->edgeTable[i] - 1), tableSize);
+        while (table[slot] != 0)
+            slot = (slot + 1) & (tableSize - 1);
+
+        table[slot] = graph->edgeTable[i];
+    }
+
+    free(graph->edgeTable);
+    graph->edgeTable = table;
+    graph->edgeTableSize = tableSize;
+    return 0;
+}
+
+/**
+ * @brief Returns the index of the vertex with the specified id and adds the vertex, if
+ * it is not part of the graph yet.
+ *
+ * @param graph Pointer to the graph
+ * @param id Id of the vertex
+ * @param index Pointer which will be set to the index of the vertex
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+static int internVertex(struct graph *graph, uint32_t id, uint32_t *index)
+{
+    if (growVertexTable(graph) == -1)
+        return -1;
+
+    size_t slot = getSlot(hashVertex(id), graph->vertexTableSize);
+    while (graph->vertexTable[slot] != 0)
+    {
+        if (graph->vertexIds[graph->vertexTable[slot] - 1] == id)
+        {
+            *index = graph->vertexTable[slot] - 1;
+            return 0;
+        }
+
+        slot = (slot + 1) & (graph->vertexTableSize - 1);
+    }
+
+    uint32_t **arrays[] = {&graph->vertexIds};
+    if (growArrays(arrays, 1, graph->vertexCount, &graph->vertexCapacity) == -1)
+        return -1;
+
+    graph->vertexIds[graph->vertexCount] = id;
+    graph->vertexTable[slot] = graph->vertexCount + 1;
+    *index = graph->vertexCount++;
+    return 0;
+}
+
+int addEdge(struct graph *graph, uint32_t id1, uint32_t id2)
+{
+    uint32_t vertex1, vertex2;
+    if (internVertex(graph, id1, &vertex1) == -1 || internVertex(graph, id2, &vertex2) == -1 || growEdgeTable(graph) == -1)
+        return -1;
+
+    // the key is the same for both directions of the edge
+    uint64_t key = (vertex1 < vertex2) ? ((uint64_t)vertex1 << 32 | vertex2) : ((uint64_t)vertex2 << 32 | vertex1);
+    size_t slot = getSlot(hashEdge(key), graph->edgeTableSize);
+    while (graph->edgeTable[slot] != 0)
+    {
+        if (graph->edgeTable[slot] == key + 1)
+            return 0;
+
+        slot = (slot + 1) & (graph->edgeTableSize - 1);
+    }
+
+    uint32_t **arrays[] = {&graph->edgeVertices1, &graph->edgeVertices2};
+    if (growArrays(arrays, 2, graph->edgeCount, &graph->edgeCapacity) == -1)
+        return -1;
+
+    graph->edgeVertices1[graph->edgeCount] = vertex1;
+    graph->edgeVertices2[graph->edgeCount] = vertex2;
+    graph->edgeTable[slot] = key + 1;
+    graph->edgeCount++;
+
+    return 0;
+}
+
+/**
+ * @brief Adds the edge, which the parser has parsed, to the graph and resets the parser
+ *
+ * @param graph Pointer to the graph
+ * @param parser Pointer to the parser, which is at the end of an edge
+ * @return 0 on success and -1 on error (with errno EINVAL or ENOMEM)
+ */
+static int finishEdge(struct graph *graph, struct edgeParser *parser)
+{
+    if (parser->part != 1 || parser->hasDigits == false)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    int returnValue = addEdge(graph, parser->ids[0], parser->ids[1]);
+    if (returnValue == -1)
+        errno = ENOMEM;
+
+    memset(parser, 0, sizeof(*parser));
+    return returnValue;
+}
+
+/**
+ * @brief Passes the next character of the text to the parser. Edges are separated by
+ * whitespace and added to the graph at their end.
+ *
+ * @param graph Pointer to the graph
+ * @param parser Pointer to the parser
+ * @param character The next character
+ * @return 0 on success and -1 on error (with errno EINVAL or ENOMEM)
+ */
+static int parseCharacter(struct graph *graph, struct edgeParser *parser, char character)
+{
+    if (character >= '0' && character <= '9')
+    {
+        parser->ids[parser->part] = parser->ids[parser->part] * 10 + (character - '0');
+        parser->hasDigits = true;
+        parser->isInEdge = true;
+
+        if (parser->ids[parser->part] > UINT32_MAX)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+    }
+    else if (character == '-' && parser->part == 0 && parser->hasDigits == true)
+    {
+        parser->part = 1;
+        parser->hasDigits = false;
+    }
+    else if (character == ' ' || character == '\n' || character == '\t' || character == '\r')
+    {
+        if (parser->isInEdge == true)
+            return finishEdge(graph, parser);
+    }
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    return 0;
+}
+
+int addEdgeText(struct graph *graph, const char *text)
+{
+    struct edgeParser parser = {{0, 0}, 0, false, false};
+
+    for (; *text != '\0'; text++)
+    {
+        // whitespace would separate several edges
+        if (*text == ' ' || *text == '\n' || *text == '\t' || *text == '\r')
+        {
+            errno = EINVAL;
+            return -1;
+        }
+
+        if (parseCharacter(graph, &parser, *text) == -1)
+            return -1;
+    }
+
+    return finishEdge(graph, &parser);
+}
+
+int readGraph(struct graph *graph, FILE *file)
+{
+    char *buffer = malloc(GRAPH_READ_BUFFER_SIZE);
+    if (buffer == NULL)
+        return -1;
+
+    struct edgeParser parser = {{0, 0}, 0, false, false};
+    int returnValue = 0;
+    size_t bytesRead;
+
+    while (returnValue == 0 && (bytesRead = fread(buffer, 1, GRAPH_READ_BUFFER_SIZE, file)) > 0)
+    {
+        for (size_t i = 0; i < bytesRead && returnValue == 0; i++)
+            returnValue = parseCharacter(graph, &parser, buffer[i]);
+    }
+
+    // the last edge doesn't need whitespace after it
+    if (returnValue == 0 && ferror(file) != 0)
+        returnValue = -1;
+    else if (returnValue == 0 && parser.isInEdge == true)
+        returnValue = finishEdge(graph, &parser);
+
+    free(buffer);
+    return returnValue;
+}
+
+int buildAdjacency(struct graph *graph)
+{
+    free(graph->adjacencyOffsets);
+    free(graph->adjacency);
+
+    graph->adjacencyOffsets = calloc((size_t)graph->vertexCount + 1, sizeof(uint32_t));
+    graph->adjacency = malloc(sizeof(uint32_t) * 2 * ((size_t)graph->edgeCount + 1));
+    if (graph->adjacencyOffsets == NULL || graph->adjacency == NULL)
+        return -1;
+
+    // count the neighbours of every vertex and sum them up to the offsets
+    for (uint32_t i = 0; i < graph->edgeCount; i++)
+    {
+        graph->adjacencyOffsets[graph->edgeVertices1[i] + 1]++;
+        graph->adjacencyOffsets[graph->edgeVertices2[i] + 1]++;
+    }
+
+    for (uint32_t i = 0; i < graph->vertexCount; i++)
+        graph->adjacencyOffsets[i + 1] += graph->adjacencyOffsets[i];
+
+    // fill the neighbours, the offsets are moved to the end of the neighbours and back
+    for (uint32_t i = 0; i < graph->edgeCount; i++)
+    {
+        graph->adjacency[graph->adjacencyOffsets[graph->edgeVertices1[i]]++] = graph->edgeVertices2[i];
+        graph->adjacency[graph->adjacencyOffsets[graph->edgeVertices2[i]]++] = graph->edgeVertices1[i];
+    }
+
+    for (uint32_t i = graph->vertexCount; i > 0; i--)
+        graph->adjacencyOffsets[i] = graph->adjacencyOffsets[i - 1];
+    graph->adjacencyOffsets[0] = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Returns the size of the image of a graph in bytes
+ *
+ * @param vertexCount Amount of vertices of the graph
+ * @param edgeCount Amount of edges of the graph
+ * @return The size of the amounts and the arrays of the image
+ */
+static size_t getImageSize(uint32_t vertexCount, uint32_t edgeCount)
+{
+    return sizeof(uint32_t) * (2 + (size_t)vertexCount + 2 * (size_t)edgeCount);
+}
+
+int publishGraph(const struct graph *graph, const char *name)
+{
+    size_t size = getImageSize(graph->vertexCount, graph->edgeCount);
+
+    int shmfd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (shmfd == -1)
+        return -1;
+
+    uint32_t *image = MAP_FAILED;
+    if (ftruncate(shmfd, size) == 0)
+        image = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+
+    if (image == MAP_FAILED)
+    {
+        int error = errno;
+        close(shmfd);
+        shm_unlink(name);
+        errno = error;
+        return -1;
+    }
+
+    close(shmfd);
+
+    image[0] = graph->vertexCount;
+    image[1] = graph->edgeCount;
+    if (graph->edgeCount > 0)
+    {
+        memcpy(&image[2], graph->vertexIds, sizeof(uint32_t) * graph->vertexCount);
+        memcpy(&image[2 + graph->vertexCount], graph->edgeVertices1, sizeof(uint32_t) * graph->edgeCount);
+        memcpy(&image[2 + graph->vertexCount + graph->edgeCount], graph->edgeVertices2, sizeof(uint32_t) * graph->edgeCount);
+    }
+
+    return munmap(image, size);
+}
+
+int attachGraph(struct graph *graph, const char *name)
+{
+    int shmfd = shm_open(name, O_RDONLY, 0);
+    if (shmfd == -1)
+        return -1;
+
+    struct stat status;
+    uint32_t *image = MAP_FAILED;
+    if (fstat(shmfd, &status) == 0)
+    {
+        if (status.st_size >= (off_t)getImageSize(0, 0))
+            image = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, shmfd, 0);
+        else
+            errno = EINVAL;
+    }
+
+    int error = errno;
+    close(shmfd);
+    errno = error;
+
+    if (image == MAP_FAILED)
+        return -1;
+
+    // the image has to contain the arrays of its amounts
+    if ((size_t)status.st_size < getImageSize(image[0], image[1]))
+    {
+        munmap(image, status.st_size);
+        errno = EINVAL;
+        return -1;
+    }
+
+    initGraph(graph);
+    graph->vertexCount = image[0];
+    graph->edgeCount = image[1];
+    graph->vertexIds = &image[2];
+    graph->edgeVertices1 = &image[2 + graph->vertexCount];
+    graph->edgeVertices2 = &image[2 + graph->vertexCount + graph->edgeCount];
+    graph->image = image;
+    graph->imageSize = status.st_size;
+
+    return 0;
+}
+
+int unlinkGraph(const char *name)
+{
+    return shm_unlink(name);
+}
+
+void freeGraph(struct graph *graph)
+{
+    if (graph->image != NULL)
+    {
+        munmap(graph->image, graph->imageSize);
+    }
+    else
+    {
+        free(graph->vertexIds);
+        free(graph->edgeVertices1);
+        free(graph->edgeVertices2);
+    }
+
+    free(graph->adjacencyOffsets);
+    free(graph->adjacency);
+    free(graph->vertexTable);
+    free(graph->edgeTable);
+
+    initGraph(graph);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file graph.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the flat representation of the graph.
+ *
+ * This module defines the structure for the graph and the functions concerning
+ * the graph. The functionality includes adding edges (also from their text form
+ * "number-number" and from files), building the adjacency of the vertices,
+ * publishing the graph as read-only image in a shared memory and attaching to
+ * such an image and freeing the graph. The vertices are numbered densely from 0 on, so the colors
+ * of a coloring fit in a contiguous array, and the edges are stored as two arrays
+ * of vertex indices instead of pointers.
+ */
+
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Size of the blocks, in which a graph file is read
+ */
+#define GRAPH_READ_BUFFER_SIZE (1 << 16)
+
+/**
+ * @brief Datatype of the graph
+ * @details Vertex i has the id vertexIds[i] (the number of its name, which is also
+ * the id in the solutions). Edge i connects the vertices edgeVertices1[i] and
+ * edgeVertices2[i]. Because the graph is undirected, it isn't important which vertex
+ * is the first or the second one. The adjacency is only built by buildAdjacency
+ * (otherwise it is NULL): the neighbours of vertex i are adjacency[adjacencyOffsets[i]]
+ * up to (excluding) adjacency[adjacencyOffsets[i + 1]].
+ * The vertices and edges are indexed by open addressing hash tables, which are never
+ * more than half full, so adding an edge takes constant time on average: vertexTable
+ * contains the index + 1 of a vertex at the slot of its id, edgeTable the key of an
+ * edge (see addEdge) + 1 at the slot of the key. Empty slots are 0.
+ * If the graph is attached to an image (see attachGraph), image points to the mapped
+ * image, which contains the vertexIds and edge arrays and must not be written to, and
+ * the graph has no hash tables.
+ */
+struct graph
+{
+    uint32_t vertexCount;
+    uint32_t edgeCount;
+    uint32_t *vertexIds;
+    uint32_t *edgeVertices1;
+    uint32_t *edgeVertices2;
+    uint32_t *adjacencyOffsets;
+    uint32_t *adjacency;
+    size_t vertexCapacity;
+    size_t edgeCapacity;
+    uint32_t *vertexTable;
+    uint64_t *edgeTable;
+    size_t vertexTableSize;
+    size_t edgeTableSize;
+    void *image;
+    size_t imageSize;
+};
+
+/**
+ * @brief This function initializes an empty graph.
+ *
+ * @param graph Pointer to the graph which should be initialized
+ */
+void initGraph(struct graph *graph);
+
+/**
+ * @brief This function adds the edge between the vertices with the specified ids to
+ * the graph. Vertices, which are not part of the graph yet, are added first. If the
+ * graph already contains the edge (in any direction), nothing is added.
+ * @details The arrays grow geometrically. The key of an edge in the edgeTable consists of
+ * the smaller vertex index (upper 32 bits) and the larger one (lower 32 bits). The adjacency
+ * is not updated, buildAdjacency has to be called after the last edge is added.
+ *
+ * @param graph Pointer to the graph
+ * @param id1 Id of one vertex of the edge
+ * @param id2 Id of the other vertex of the edge
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+int addEdge(struct graph *graph, uint32_t id1, uint32_t id2);
+
+/**
+ * @brief This function adds the edge in the text form "number-number" to the graph, where
+ * the numbers are the ids of its vertices (see addEdge).
+ *
+ * @param graph Pointer to the graph
+ * @param text The edge as null-terminated string
+ * @return 0 on success and -1 on error, errno is EINVAL, if the text isn't an edge, and
+ * ENOMEM, if the allocation of memory failed
+ */
+int addEdgeText(struct graph *graph, const char *text);
+
+/**
+ * @brief This function reads edges in the text form "number-number", which are separated by
+ * whitespace, from the file and adds them to the graph (see addEdge). The file is read in
+ * blocks of GRAPH_READ_BUFFER_SIZE until its end.
+ *
+ * @param graph Pointer to the graph
+ * @param file Pointer to the file (e.g. stdin)
+ * @return 0 on success and -1 on error, errno is EINVAL, if the file contains something else
+ * than edges, ENOMEM, if the allocation of memory failed, or the error of reading the file
+ */
+int readGraph(struct graph *graph, FILE *file);
+
+/**
+ * @brief This function builds the adjacency (compressed sparse rows) of the graph.
+ * Every edge appears in the neighbours of both of its vertices.
+ *
+ * @param graph Pointer to the graph
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+int buildAdjacency(struct graph *graph);
+
+/**
+ * @brief This function creates a shared memory with the specified name and writes the
+ * image of the graph to it: the amount of vertices and edges followed by the arrays
+ * vertexIds, edgeVertices1 and edgeVertices2 (all uint32_t). The hash tables and the
+ * adjacency are not part of the image.
+ * @details The shared memory has to be removed by unlinkGraph, processes which are attached
+ * to it can still use it afterwards.
+ *
+ * @param graph Pointer to the graph
+ * @param name Name of the shared memory, which must not exist yet
+ * @return 0 on success and -1 on error (with errno set)
+ */
+int publishGraph(const struct graph *graph, const char *name);
+
+/**
+ * @brief This function initializes the graph with the image in the shared memory with
+ * the specified name (see publishGraph). The image is mapped read-only, so the arrays
+ * are not copied and are shared by all processes, which are attached to it.
+ * @details No edges can be added to an attached graph, but the adjacency can be built.
+ * freeGraph unmaps the image.
+ *
+ * @param graph Pointer to the graph which should be initialized
+ * @param name Name of the shared memory
+ * @return 0 on success and -1 on error (with errno set, EINVAL if the image is too small)
+ */
+int attachGraph(struct graph *graph, const char *name);
+
+/**
+ * @brief This function removes the shared memory of a published graph.
+ *
+ * @param name Name of the shared memory
+ * @return 0 on success and -1 on error (with errno set)
+ */
+int unlinkGraph(const char *name);
+
+/**
+ * @brief This function frees all the allocated memory of the graph (or unmaps its image).
+ * @details The graph is empty afterwards and has to be initialized again, before it
+ * is used.
+ *
+ * @param graph Pointer to the graph
+ */
+void freeGraph(struct graph *graph);
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file localSearch.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods of the min-conflicts local search.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "localSearch.h"
+
+/**
+ * @brief Amount of steps per vertex without a new best coloring, after which the search is stuck
+ */
+#define STUCK_STEPS_PER_VERTEX 64
+
+/**
+ * @brief Minimal amount of steps, which a color is tabu
+ */
+#define MIN_TABU_TENURE 10
+
+/**
+ * @brief A step, which leads to more conflicts, is only taken once in this many times
+ */
+#define WORSENING_STEP_ODDS 16
+
+/**
+ * @brief Returns a random number below the limit
+ * @details The upper 32 bits of the random number are scaled to the limit (the bias is negligible).
+ *
+ * @param randomGenerator Pointer to the random number generator
+ * @param limit The limit (at least 1)
+ * @return A random number from 0 to limit - 1
+ */
+static uint32_t getRandomBelow(struct randomGenerator *randomGenerator, uint32_t limit)
+{
+    return ((nextRandom(randomGenerator) >> 32) * limit) >> 32;
+}
+
+/**
+ * @brief Sets the amount of conflicts of the vertex and adds it to or removes it from the
+ * vertices with conflicts
+ *
+ * @param localSearch Pointer to the local search
+ * @param vertex Index of the vertex
+ * @param count The new amount of conflicts
+ */
+static void setConflictCount(struct localSearch *localSearch, uint32_t vertex, uint32_t count)
+{
+    uint32_t oldCount = localSearch->conflictCounts[vertex];
+
+    if (oldCount == 0 && count > 0)
+    {
+        localSearch->conflictPositions[vertex] = localSearch->conflictingCount;
+        localSearch->conflictingVertices[localSearch->conflictingCount++] = vertex;
+    }
+    else if (oldCount > 0 && count == 0)
+    {
+        // the last vertex with conflicts takes the position of the vertex
+        uint32_t lastVertex = localSearch->conflictingVertices[--localSearch->conflictingCount];
+        localSearch->conflictingVertices[localSearch->conflictPositions[vertex]] = lastVertex;
+        localSearch->conflictPositions[lastVertex] = localSearch->conflictPositions[vertex];
+    }
+
+    localSearch->conflictCounts[vertex] = count;
+}
+
+int initLocalSearch(struct localSearch *localSearch, const struct graph *graph)
+{
+    size_t vertexCount = graph->vertexCount;
+
+    memset(localSearch, 0, sizeof(struct localSearch));
+    localSearch->graph = graph;
+    localSearch->colors = malloc(vertexCount + 1);
+    localSearch->conflictCounts = calloc(vertexCount + 1, sizeof(uint32_t));
+    localSearch->conflictingVertices = malloc((vertexCount + 1) * sizeof(uint32_t));
+    localSearch->conflictPositions = malloc((vertexCount + 1) * sizeof(uint32_t));
+    localSearch->tabuUntil = calloc(3 * vertexCount + 1, sizeof(uint64_t));
+
+    if (localSearch->colors == NULL || localSearch->conflictCounts == NULL || localSearch->conflictingVertices == NULL ||
+        localSearch->conflictPositions == NULL || localSearch->tabuUntil == NULL)
+    {
+        freeLocalSearch(localSearch);
+        return -1;
+    }
+
+    return 0;
+}
+
+void restartLocalSearch(struct localSearch *localSearch, struct randomGenerator *randomGenerator)
+{
+    const struct graph *graph = localSearch->graph;
+    uint8_t *colors = localSearch->colors;
+
+    fillRandomColors(randomGenerator, colors, graph->vertexCount);
+
+    // the steps go on, so the old tabus expire by themselves
+    memset(localSearch->conflictCounts, 0, graph->vertexCount * sizeof(uint32_t));
+    localSearch->conflictingCount = 0;
+    localSearch->conflictEdgeCount = 0;
+
+    for (uint32_t i = 0; i < graph->edgeCount; i++)
+    {
+        uint32_t vertex1 = graph->edgeVertices1[i], vertex2 = graph->edgeVertices2[i];
+        if (colors[vertex1] != colors[vertex2])
+            continue;
+
+        localSearch->conflictEdgeCount++;
+        if (vertex1 != vertex2)
+        {
+            setConflictCount(localSearch, vertex1, localSearch->conflictCounts[vertex1] + 1);
+            setConflictCount(localSearch, vertex2, localSearch->conflictCounts[vertex2] + 1);
+        }
+    }
+
+    localSearch->bestConflictEdgeCount = localSearch->conflictEdgeCount;
+    localSearch->lastImprovement = localSearch->step;
+}
+
+bool stepLocalSearch(struct localSearch *localSearch, struct randomGenerator *randomGenerator)
+{
+    const struct graph *graph = localSearch->graph;
+    uint8_t *colors = localSearch->colors;
+
+    if (localSearch->conflictingCount == 0)
+        return false;
+
+    localSearch->step++;
+
+    // count the colors of the neighbours of a random vertex with conflicts
+    uint32_t vertex = localSearch->conflictingVertices[getRandomBelow(randomGenerator, localSearch->conflictingCount)];
+    const uint32_t *neighbours = &graph->adjacency[graph->adjacencyOffsets[vertex]];
+    uint32_t neighbourCount = graph->adjacencyOffsets[vertex + 1] - graph->adjacencyOffsets[vertex];
+    uint32_t colorCounts[3] = {0, 0, 0};
+
+    for (uint32_t i = 0; i < neighbourCount; i++)
+    {
+        if (neighbours[i] != vertex)
+            colorCounts[colors[neighbours[i]]]++;
+    }
+
+    // choose the better of the other colors, which are tried in random order to break ties
+    uint8_t oldColor = colors[vertex];
+    uint32_t offset = 1 + (nextRandom(randomGenerator) & 1);
+    int newColor = -1;
+
+    for (int i = 0; i < 2; i++)
+    {
+        uint8_t color = (oldColor + ((i == 0) ? offset : 3 - offset)) % 3;
+        uint32_t conflictEdgeCount = localSearch->conflictEdgeCount - colorCounts[oldColor] + colorCounts[color];
+        bool isAllowed = localSearch->tabuUntil[3 * (size_t)vertex + color] <= localSearch->step ||
+                         conflictEdgeCount < localSearch->bestConflictEdgeCount;
+
+        if (isAllowed == true && (newColor == -1 || colorCounts[color] < colorCounts[newColor]))
+            newColor = color;
+    }
+
+    // mostly stay on the current color instead of a worse one, but not always to escape local minima
+    if (newColor == -1 || (colorCounts[newColor] > colorCounts[oldColor] && nextRandom(randomGenerator) % WORSENING_STEP_ODDS != 0))
+        return false;
+
+    // recolor the vertex and update the conflicts of its neighbours
+    for (uint32_t i = 0; i < neighbourCount; i++)
+    {
+        uint32_t neighbour = neighbours[i];
+        if (neighbour != vertex && colors[neighbour] == oldColor)
+            setConflictCount(localSearch, neighbour, localSearch->conflictCounts[neighbour] - 1);
+        else if (neighbour != vertex && colors[neighbour] == newColor)
+            setConflictCount(localSearch, neighbour, localSearch->conflictCounts[neighbour] + 1);
+    }
+
+    colors[vertex] = newColor;
+    setConflictCount(localSearch, vertex, colorCounts[newColor]);
+    localSearch->conflictEdgeCount += colorCounts[newColor] - colorCounts[oldColor];
+    localSearch->tabuUntil[3 * (size_t)vertex + oldColor] = localSearch->step + MIN_TABU_TENURE +
+                                                            getRandomBelow(randomGenerator, localSearch->conflictingCount + 1);
+
+    if (localSearch->conflictEdgeCount >= localSearch->bestConflictEdgeCount)
+        return false;
+
+    localSearch->bestConflictEdgeCount = localSearch->conflictEdgeCount;
+    localSearch->lastImprovement = localSearch->step;
+    return true;
+}
+
+bool isLocalSearchStuck(const struct localSearch *localSearch)
+{
+    return localSearch->step - localSearch->lastImprovement > STUCK_STEPS_PER_VERTEX * (uint64_t)localSearch->graph->vertexCount;
+}
+
+uint32_t collectConflicts(const struct localSearch *localSearch, uint32_t *vertices, uint32_t count)
+{
+    const struct graph *graph = localSearch->graph;
+    uint32_t collected = 0;
+
+    for (uint32_t i = 0; i < graph->edgeCount && collected < count; i++)
+    {
+        if (localSearch->colors[graph->edgeVertices1[i]] == localSearch->colors[graph->edgeVertices2[i]])
+        {
+            vertices[2 * collected] = graph->vertexIds[graph->edgeVertices1[i]];
+            vertices[2 * collected + 1] = graph->vertexIds[graph->edgeVertices2[i]];
+            collected++;
+        }
+    }
+
+    return collected;
+}
+
+void freeLocalSearch(struct localSearch *localSearch)
+{
+    free(localSearch->colors);
+    free(localSearch->conflictCounts);
+    free(localSearch->conflictingVertices);
+    free(localSearch->conflictPositions);
+    free(localSearch->tabuUntil);
+    memset(localSearch, 0, sizeof(struct localSearch));
+}
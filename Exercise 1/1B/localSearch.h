@@ -0,0 +1,109 @@
+/**
+ * @file localSearch.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the min-conflicts local search for a 3coloring.
+ *
+ * This module defines the structure for the state of a local search and the functions
+ * concerning it. Instead of coloring all vertices randomly again and again, the local
+ * search starts with a random coloring and repeatedly recolors a random vertex with
+ * conflicts (a neighbour with the same color) with the color, which has the fewest
+ * conflicts, if it isn't worse than the current one. To not undo its own steps, the old
+ * color of a recolored vertex is tabu for a few steps. The conflicts are updated incrementally over the neighbours of the vertex,
+ * so a step only takes time proportional to its degree.
+ */
+
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "randomGenerator.h"
+
+/**
+ * @brief Datatype of the state of a local search
+ * @details colors contains the color of every vertex index (0 to 2), conflictCounts the amount
+ * of neighbours with the same color (an edge from a vertex to itself doesn't count, because no
+ * color solves it). The vertices with conflicts are the first conflictingCount entries of
+ * conflictingVertices, conflictPositions contains the position of such a vertex in it.
+ * tabuUntil contains for every vertex and color (3 * index + color) the step, until which the
+ * vertex must not get the color, unless it leads to fewer conflicting edges than ever since
+ * the last restart (bestConflictEdgeCount). conflictEdgeCount is the amount of edges with
+ * same colored vertices (including edges from a vertex to itself).
+ */
+struct localSearch
+{
+    const struct graph *graph;
+    uint8_t *colors;
+    uint32_t *conflictCounts;
+    uint32_t *conflictingVertices;
+    uint32_t *conflictPositions;
+    uint64_t *tabuUntil;
+    uint32_t conflictingCount;
+    uint32_t conflictEdgeCount;
+    uint32_t bestConflictEdgeCount;
+    uint64_t step;
+    uint64_t lastImprovement;
+};
+
+/**
+ * @brief This function initializes the local search for the graph and allocates its memory.
+ * @details The adjacency of the graph has to be built (see buildAdjacency). The local search
+ * has to be restarted, before the first step.
+ *
+ * @param localSearch Pointer to the local search which should be initialized
+ * @param graph Pointer to the graph
+ * @return 0 on success and -1 if the allocation of memory failed
+ */
+int initLocalSearch(struct localSearch *localSearch, const struct graph *graph);
+
+/**
+ * @brief This function restarts the local search with a random coloring and counts its conflicts.
+ *
+ * @param localSearch Pointer to the local search
+ * @param randomGenerator Pointer to the random number generator
+ */
+void restartLocalSearch(struct localSearch *localSearch, struct randomGenerator *randomGenerator);
+
+/**
+ * @brief This function recolors a random vertex with conflicts with the better one of the other
+ * colors, which aren't tabu. If it has more conflicts than the current color, the vertex is only
+ * recolored once in WORSENING_STEP_ODDS times (see localSearch.c), otherwise it keeps its color.
+ *
+ * @param localSearch Pointer to the local search
+ * @param randomGenerator Pointer to the random number generator
+ * @return true, if the coloring has fewer conflicting edges than ever since the last restart
+ */
+bool stepLocalSearch(struct localSearch *localSearch, struct randomGenerator *randomGenerator);
+
+/**
+ * @brief This function checks if the local search is stuck, because the amount of conflicting
+ * edges hasn't fallen for too many steps (64 per vertex), so it should be restarted.
+ *
+ * @param localSearch Pointer to the local search
+ * @return true, if the local search is stuck
+ */
+bool isLocalSearchStuck(const struct localSearch *localSearch);
+
+/**
+ * @brief This function collects the conflicting edges of the coloring in the order of the edges.
+ * The ids of the vertices of conflicting edge i are saved to vertices[2 * i] and vertices[2 * i + 1].
+ *
+ * @param localSearch Pointer to the local search
+ * @param vertices Pointer to the vertex ids, which have room for count edges
+ * @param count Maximal amount of edges, which are collected
+ * @return The amount of collected edges
+ */
+uint32_t collectConflicts(const struct localSearch *localSearch, uint32_t *vertices, uint32_t count);
+
+/**
+ * @brief This function frees all the allocated memory of the local search.
+ * @details A local search, which is filled with zeros, can be freed too.
+ *
+ * @param localSearch Pointer to the local search
+ */
+void freeLocalSearch(struct localSearch *localSearch);
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file randomGenerator.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to seed the random number
+ * generator, to generate random numbers and to fill random colors and color planes.
+ */
+
+#include "randomGenerator.h"
+
+/**
+ * @brief Rotates the bits of the value to the left
+ *
+ * @param value The value
+ * @param count Amount of bits (1 to 63)
+ * @return The rotated value
+ */
+static uint64_t rotateLeft(uint64_t value, int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+void seedRandomGenerator(struct randomGenerator *randomGenerator, uint64_t seed)
+{
+    // splitmix64 never returns four zeros in a row
+    for (int i = 0; i < 4; i++)
+    {
+        uint64_t value = (seed += UINT64_C(0x9E3779B97F4A7C15));
+        value = (value ^ (value >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        value = (value ^ (value >> 27)) * UINT64_C(0x94D049BB133111EB);
+        randomGenerator->state[i] = value ^ (value >> 31);
+    }
+}
+
+uint64_t nextRandom(struct randomGenerator *randomGenerator)
+{
+    uint64_t *state = randomGenerator->state;
+    uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+
+    return result;
+}
+
+void fillRandomColors(struct randomGenerator *randomGenerator, uint8_t *colors, size_t count)
+{
+    size_t i = 0;
+    while (i < count)
+    {
+        uint64_t bits = nextRandom(randomGenerator);
+
+        // a color 3 is overwritten by the next one, because i doesn't move on
+        for (int j = 0; j < 32 && i < count; j++, bits >>= 2)
+        {
+            uint8_t color = bits & 3;
+            colors[i] = color;
+            i += (color != 3);
+        }
+    }
+}
+
+void fillRandomColorPlanes(struct randomGenerator *randomGenerator, uint64_t *planes, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t low = nextRandom(randomGenerator);
+        uint64_t high = nextRandom(randomGenerator);
+
+        // only the lanes with color 3 get new bits, so every lane stays uniformly distributed
+        for (uint64_t invalid = low & high; invalid != 0; invalid = low & high)
+        {
+            low = (low & ~invalid) | (nextRandom(randomGenerator) & invalid);
+            high = (high & ~invalid) | (nextRandom(randomGenerator) & invalid);
+        }
+
+        planes[2 * i] = low;
+        planes[2 * i + 1] = high;
+    }
+}
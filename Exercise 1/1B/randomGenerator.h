@@ -0,0 +1,70 @@
+/**
+ * @file randomGenerator.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the random number generator of the solvers.
+ *
+ * This module defines the structure for the random number generator and the
+ * functions concerning it. The generator is xoshiro256**, which has no hidden
+ * state or lock (unlike rand), so every thread can use its own generator. The
+ * colors of a coloring are generated in bulk, up to 32 out of one random number,
+ * or bit-sliced for 64 colorings at once (see fillRandomColorPlanes).
+ */
+
+#ifndef RANDOMGENERATOR_H
+#define RANDOMGENERATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Datatype of the random number generator
+ * @details The state must not be zero, seedRandomGenerator ensures this.
+ */
+struct randomGenerator
+{
+    uint64_t state[4];
+};
+
+/**
+ * @brief This function initializes the random number generator with the seed. Different
+ * seeds (e.g. the process id and the number of the thread) result in independent sequences.
+ *
+ * @param randomGenerator Pointer to the random number generator
+ * @param seed The seed, which is expanded to the state with splitmix64
+ */
+void seedRandomGenerator(struct randomGenerator *randomGenerator, uint64_t seed);
+
+/**
+ * @brief This function returns the next random number.
+ *
+ * @param randomGenerator Pointer to the random number generator
+ * @return 64 random bits
+ */
+uint64_t nextRandom(struct randomGenerator *randomGenerator);
+
+/**
+ * @brief This function fills the colors with random colors 0, 1 and 2, which are uniformly
+ * distributed. Every color is taken from two random bits, the value 3 is rejected without
+ * a branch, so a random number yields 24 colors on average.
+ *
+ * @param randomGenerator Pointer to the random number generator
+ * @param colors Pointer to the colors, which are filled
+ * @param count Amount of colors
+ */
+void fillRandomColors(struct randomGenerator *randomGenerator, uint8_t *colors, size_t count);
+
+/**
+ * @brief This function fills the color planes of 64 independent colorings with random colors
+ * 0, 1 and 2, which are uniformly distributed. The color of vertex i in coloring (lane) j
+ * consists of bit j of planes[2 * i] (low bit) and bit j of planes[2 * i + 1] (high bit).
+ * @details The lanes with the color 3 are drawn again, until no lane of the vertex has it.
+ *
+ * @param randomGenerator Pointer to the random number generator
+ * @param planes Pointer to the planes, which are filled (two per vertex)
+ * @param count Amount of vertices
+ */
+void fillRandomColorPlanes(struct randomGenerator *randomGenerator, uint64_t *planes, size_t count);
+
+#endif
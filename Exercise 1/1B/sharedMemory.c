@@ -9,13 +9,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <errno.h>
 #include "sharedMemory.h"
 
-struct sharedMemory *openSharedMemory(int *shmfd, bool isServer)
+struct sharedMemory *openSharedMemory(int *shmfd, bool isServer, bool hasGraph)
 {
     int oFlag = (isServer == true) ? O_RDWR | O_CREAT | O_EXCL : O_RDWR;
 
@@ -46,9 +47,12 @@ struct sharedMemory *openSharedMemory(int *shmfd, bool isServer)
     // set all attributes if the server creates the shared memory
     if (isServer == true)
     {
+        sharedMemory->head = 0;
+        sharedMemory->tail = 0;
+        sharedMemory->waitingWriters = 0;
+        sharedMemory->bestSoFar = MAX_SOLUTION_LENGTH;
         sharedMemory->isAlive = true;
-        sharedMemory->readPos = 0;
-        sharedMemory->writePos = 0;
+        sharedMemory->hasGraph = hasGraph;
         memset(sharedMemory->buffer, 0, BUFFER_LENGTH);
     }
 
@@ -75,3 +79,17 @@ int closeSharedMemory(struct sharedMemory *sharedMemory, int *shmfd, bool isServ
 
     return returnValue;
 }
+
+bool lowerBestSoFar(struct sharedMemory *sharedMemory, uint32_t edgeCount)
+{
+    uint32_t bestSoFar = __atomic_load_n(&sharedMemory->bestSoFar, __ATOMIC_RELAXED);
+
+    // retry, until the value is lowered or another solution is already as good
+    while (edgeCount < bestSoFar)
+    {
+        if (__atomic_compare_exchange_n(&sharedMemory->bestSoFar, &bestSoFar, edgeCount, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == true)
+            return true;
+    }
+
+    return false;
+}
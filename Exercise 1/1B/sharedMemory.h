@@ -14,9 +14,10 @@
 #define SHAREDMEMORY_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
- * @brief Length of the buffer in bytes
+ * @brief Length of the buffer in bytes (a multiple of RECORD_ALIGNMENT)
  */
 #define BUFFER_LENGTH 2048
 
@@ -25,20 +26,71 @@
  */
 #define SHM_NAME "12041500_OSUE_SHAREDMEM"
 
+/**
+ * @brief Name of the shared memory with the graph image, which the supervisor publishes
+ */
+#define SHM_GRAPH_NAME "12041500_OSUE_GRAPH"
+
+/**
+ * @brief Definies the max length a solution can have
+ */
+#define MAX_SOLUTION_LENGTH 8
+
+/**
+ * @brief Size of a solution record with the specified amount of edges in bytes
+ */
+#define SOLUTION_SIZE(edgeCount) (sizeof(uint32_t) * (1 + 2 * (size_t)(edgeCount)))
+
+/**
+ * @brief Size of a cache line, head and tail are kept on different cache lines
+ */
+#define CACHE_LINE_SIZE 64
+
 /**
  * Data structure to implement the sharedMemory
- * @brief It contains a char[] buffer, a read-/write-position
- * and a flag, that indicates if the shared-memory is activ or not.
- * @details The buffer is a char array and not an array of pointers
- * to edges, because it not possible to write pointer into shared-
- * memory
+ * @brief It contains the buffer of the ring, the reservation (head) and
+ * read (tail) position, the amount of writers waiting for free space,
+ * the amount of edges of the best solution written so far and a flag,
+ * that indicates if the shared-memory is activ or not.
+ * @details The buffer consists of records (see circleBuffer.h) and not of
+ * pointers to edges, because it not possible to write pointer into shared-
+ * memory. head and tail count the bytes since the creation and are only
+ * accessed atomically, the position in the buffer is the count modulo
+ * BUFFER_LENGTH. The writers reserve the bytes between head and their new
+ * head, the reader frees the bytes from tail on. bestSoFar only decreases
+ * (see lowerBestSoFar), so the generators can stop scanning a coloring as
+ * soon as it can't be better. hasGraph is set by a supervisor, which
+ * published its graph (see SHM_GRAPH_NAME), while the shared memory is
+ * created, so a generator never attaches to an image, which a crashed
+ * supervisor left behind. The fields, which are written often, are
+ * kept on different cache lines than the fields, which are only read often.
  */
 struct sharedMemory
 {
-    int writePos;
-    int readPos;
+    uint64_t head;
+    char headPadding[CACHE_LINE_SIZE - sizeof(uint64_t)];
+    uint64_t tail;
+    uint32_t waitingWriters;
+    char tailPadding[CACHE_LINE_SIZE - sizeof(uint64_t) - sizeof(uint32_t)];
+    uint32_t bestSoFar;
     bool isAlive;
-    char buffer[BUFFER_LENGTH];
+    bool hasGraph;
+    char statePadding[CACHE_LINE_SIZE - sizeof(uint32_t) - 2 * sizeof(bool)];
+    uint32_t buffer[BUFFER_LENGTH / sizeof(uint32_t)];
+};
+
+/**
+ * Data structure of a solution, which is written to the circle-buffer
+ * @brief It contains the amount of removed edges and the ids of both
+ * vertices of every removed edge.
+ * @details Only the first SOLUTION_SIZE(edgeCount) bytes are written
+ * to the circle-buffer, the vertices of edge i are vertices[2 * i] and
+ * vertices[2 * i + 1].
+ */
+struct solution
+{
+    uint32_t edgeCount;
+    uint32_t vertices[2 * MAX_SOLUTION_LENGTH];
 };
 
 /**
@@ -50,9 +102,10 @@ struct sharedMemory
  * used to write directly to the shared memory, it is only saved for closeSharedMemory.
  * @param shmfd A pointer to a filedescriptor. This function will overwrite the value with a filedescriptor to the shared memory.
  * @param isServer Flag that indicates if the caller is a server (true) or client (false)
+ * @param hasGraph Flag that indicates if the server published a graph (ignored for a client)
  * @return Returns a pointer to a struct sharedMemory, which is connected to the shared memory
  */
-struct sharedMemory *openSharedMemory(int *shmfd, bool isServer);
+struct sharedMemory *openSharedMemory(int *shmfd, bool isServer, bool hasGraph);
 
 /**
  * @brief This function closes/disconnects from the shared memory depending if its a server or client
@@ -65,4 +118,17 @@ struct sharedMemory *openSharedMemory(int *shmfd, bool isServer);
  */
 int closeSharedMemory(struct sharedMemory *sharedMemory, int *shmfd, bool isServer);
 
+/**
+ * @brief This function lowers the amount of edges of the best solution to the specified
+ * amount, if it is smaller than the current one. Only the caller, which lowered it, should
+ * write its solution to the circle-buffer, all others can't win anymore.
+ * @details The amount is changed atomically, so any amount of processes and threads can
+ * call this function at the same time.
+ *
+ * @param sharedMemory A pointer to the shared memory struct created by openSharedMemory
+ * @param edgeCount The amount of edges of the new solution
+ * @return true if the best solution was lowered, false if it is already smaller or equal
+ */
+bool lowerBestSoFar(struct sharedMemory *sharedMemory, uint32_t edgeCount);
+
 #endif
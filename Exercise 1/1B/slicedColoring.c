@@ -0,0 +1,128 @@
+/**
+ * @file slicedColoring.c
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This file implements the methods to evaluate 64 bit-sliced colorings at once.
+ */
+
+#include "slicedColoring.h"
+#include "sharedMemory.h"
+
+/**
+ * @brief Amount of bits of the conflict counters, they have to hold every bound
+ */
+#define COUNTER_BITS 4
+
+/**
+ * @brief Amount of edges, after which the lanes are compared to the bound (a power of 2)
+ */
+#define BOUND_CHECK_INTERVAL 8
+
+#if MAX_SOLUTION_LENGTH + BOUND_CHECK_INTERVAL > (1 << COUNTER_BITS)
+#error "The conflict counters are too small for MAX_SOLUTION_LENGTH"
+#endif
+
+/**
+ * @brief Computes the lanes, whose counter is less than the bound
+ * @details The counters are compared from the most significant bit on: a lane is less, as soon
+ * as it has a 0 where the bound has a 1 and all higher bits were equal.
+ *
+ * @param counters The bit-sliced counters (bit i of the counts in counters[i])
+ * @param bound The bound (less than 1 << COUNTER_BITS)
+ * @return Mask of the lanes, whose counter is less than the bound
+ */
+static uint64_t getLanesBelow(const uint64_t *counters, uint32_t bound)
+{
+    uint64_t less = 0, equal = ~UINT64_C(0);
+
+    for (int i = COUNTER_BITS - 1; i >= 0; i--)
+    {
+        if (((bound >> i) & 1) != 0)
+        {
+            less |= equal & ~counters[i];
+            equal &= counters[i];
+        }
+        else
+            equal &= ~counters[i];
+    }
+
+    return less;
+}
+
+/**
+ * @brief Computes the lanes, in which both vertices of the edge have the same color
+ *
+ * @param planes Pointer to the color planes
+ * @param vertex1 Index of one vertex of the edge
+ * @param vertex2 Index of the other vertex of the edge
+ * @return Mask of the lanes with a conflict
+ */
+static uint64_t getConflictLanes(const uint64_t *planes, uint32_t vertex1, uint32_t vertex2)
+{
+    const uint64_t *planes1 = &planes[2 * (size_t)vertex1];
+    const uint64_t *planes2 = &planes[2 * (size_t)vertex2];
+    return ~((planes1[0] ^ planes2[0]) | (planes1[1] ^ planes2[1]));
+}
+
+int findBestLane(const struct graph *graph, const uint64_t *planes, uint32_t bound, uint32_t *conflictCount)
+{
+    const uint32_t *edgeVertices1 = graph->edgeVertices1;
+    const uint32_t *edgeVertices2 = graph->edgeVertices2;
+    uint64_t counters[COUNTER_BITS] = {0};
+    uint64_t candidates = ~UINT64_C(0);
+
+    // only the candidates count on and they are compared to the bound every few edges, so no counter overflows
+    for (uint32_t i = 0; i < graph->edgeCount && candidates != 0; i++)
+    {
+        uint64_t carry = getConflictLanes(planes, edgeVertices1[i], edgeVertices2[i]) & candidates;
+
+        // add one to the counters of the lanes with a conflict (ripple carry adder)
+        for (int j = 0; j < COUNTER_BITS; j++)
+        {
+            uint64_t nextCarry = counters[j] & carry;
+            counters[j] ^= carry;
+            carry = nextCarry;
+        }
+
+        if ((i & (BOUND_CHECK_INTERVAL - 1)) == BOUND_CHECK_INTERVAL - 1)
+            candidates = getLanesBelow(counters, bound);
+    }
+
+    candidates = getLanesBelow(counters, bound);
+
+    int bestLane = -1;
+    *conflictCount = bound;
+    for (; candidates != 0; candidates &= candidates - 1)
+    {
+        int lane = __builtin_ctzll(candidates);
+        uint32_t count = 0;
+        for (int j = 0; j < COUNTER_BITS; j++)
+            count |= ((counters[j] >> lane) & 1) << j;
+
+        if (count < *conflictCount)
+        {
+            *conflictCount = count;
+            bestLane = lane;
+        }
+    }
+
+    return bestLane;
+}
+
+uint32_t collectLaneConflicts(const struct graph *graph, const uint64_t *planes, int lane, uint32_t *vertices, uint32_t count)
+{
+    uint32_t collected = 0;
+
+    for (uint32_t i = 0; i < graph->edgeCount && collected < count; i++)
+    {
+        if (((getConflictLanes(planes, graph->edgeVertices1[i], graph->edgeVertices2[i]) >> lane) & 1) != 0)
+        {
+            vertices[2 * collected] = graph->vertexIds[graph->edgeVertices1[i]];
+            vertices[2 * collected + 1] = graph->vertexIds[graph->edgeVertices2[i]];
+            collected++;
+        }
+    }
+
+    return collected;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file slicedColoring.h
+ * @author Maximilian Kleinegger <e12041500@student.tuwien.ac.at>
+ * @date 2026-10-16
+ *
+ * @brief This module defines the bit-sliced evaluation of 64 colorings at once.
+ *
+ * This module defines the functions, which evaluate 64 independent colorings of a
+ * graph in one pass over its edges. The colorings are stored bit-sliced: every vertex
+ * has two color planes (see fillRandomColorPlanes), bit j of them is the color of the
+ * vertex in coloring (lane) j. So the lanes, in which the vertices of an edge have the
+ * same color, are computed with a few bit operations for all 64 lanes together, and the
+ * amount of conflicting edges of every lane is counted in vertical (bit-sliced) counters.
+ */
+
+#ifndef SLICEDCOLORING_H
+#define SLICEDCOLORING_H
+
+#include <stdint.h>
+#include "graph.h"
+
+/**
+ * @brief Amount of colorings (lanes), which are evaluated at once
+ */
+#define LANE_COUNT 64
+
+/**
+ * @brief This function counts the conflicting edges (edges with same colored vertices) of
+ * all lanes and returns the lane with the fewest conflicts, if it has less than bound conflicts.
+ * @details The edges are only scanned until no lane can have less than bound conflicts anymore.
+ * The bound must be between 1 and MAX_SOLUTION_LENGTH.
+ *
+ * @param graph Pointer to the graph
+ * @param planes Pointer to the color planes (two per vertex)
+ * @param bound Amount of conflicts, which the best lane has to fall below
+ * @param conflictCount Pointer, which is set to the amount of conflicts of the best lane
+ * @return The best lane (0 to LANE_COUNT - 1) or -1 if every lane has at least bound conflicts
+ */
+int findBestLane(const struct graph *graph, const uint64_t *planes, uint32_t bound, uint32_t *conflictCount);
+
+/**
+ * @brief This function collects the conflicting edges of the lane in the order of the edges.
+ * The ids of the vertices of conflicting edge i are saved to vertices[2 * i] and vertices[2 * i + 1].
+ *
+ * @param graph Pointer to the graph
+ * @param planes Pointer to the color planes (two per vertex)
+ * @param lane The lane (0 to LANE_COUNT - 1)
+ * @param vertices Pointer to the vertex ids, which have room for count edges
+ * @param count Maximal amount of edges, which are collected
+ * @return The amount of collected edges
+ */
+uint32_t collectLaneConflicts(const struct graph *graph, const uint64_t *planes, int lane, uint32_t *vertices, uint32_t count);
+
+#endif
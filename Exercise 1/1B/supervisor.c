@@ -6,7 +6,9 @@
  * @brief supervisor program for the 3coloring problem
  *
  * Reads and prints solution for the 3coloring problem to stdout, if
- * it is the best so far.
+ * it is the best so far. If the supervisor gets a graph (edges as arguments
+ * and/or [-f file], - reads stdin), it publishes its image in the shared memory
+ * and the generators can attach to it instead of parsing it themselves.
  */
 #include <stdlib.h>
 #include <stdbool.h>
@@ -15,7 +17,10 @@
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
 #include "circleBuffer.h"
+#include "graph.h"
 
 /**
  * @brief Flag which decides if the process should stop
@@ -30,12 +35,50 @@ static volatile sig_atomic_t quit = 0;
  */
 static void handle_signal(int signal) { quit = 1; }
 
+/**
+ * @brief Loads the graph of the graph file (if specified) and of the arguments, which
+ * are no options.
+ *
+ * @param graphFileName The filename/path of the graph file, - for stdin, or NULL
+ * @param argc the number of arguments provided
+ * @param argv the argument-values provided
+ * @param graph Pointer to the initialized graph, where the edges are added to
+ * @return 0 on success and -1 on error (with errno set, EINVAL for invalid edges)
+ */
+static int loadGraph(char *graphFileName, int argc, char **argv, struct graph *graph)
+{
+    if (graphFileName != NULL)
+    {
+        FILE *file = (strcmp(graphFileName, "-") == 0) ? stdin : fopen(graphFileName, "r");
+        if (file == NULL)
+            return -1;
+
+        int returnValue = readGraph(graph, file);
+        int error = errno;
+        if (file != stdin)
+            fclose(file);
+
+        errno = error;
+        if (returnValue == -1)
+            return -1;
+    }
+
+    for (int i = optind; i < argc; i++)
+    {
+        if (addEdgeText(graph, argv[i]) == -1)
+            return -1;
+    }
+
+    return 0;
+}
+
 /**
  * Supervisors entry point.
  * @brief This function opens and closes the circle-buffer and also does
  * the reading and printing of the new solutions found by the generators.
  * The programm will only terminate if a signal interrupts the process or
- * the graph is 3colorable!
+ * the graph is 3colorable! The graph is published before the circle-buffer
+ * is opened, so it is complete as soon as the generators can connect.
  * @details global variables: quit
  * @param argc the number of arguments provided
  * @param argv the argument-values provided
@@ -43,11 +86,18 @@ static void handle_signal(int signal) { quit = 1; }
  */
 int main(int argc, char *argv[])
 {
-    // if any arguments are provided the program terminates
-    if (argc > 1)
+    // parse the options, the edges are the remaining arguments
+    char *graphFileName = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:")) != -1)
     {
-        fprintf(stderr, "Usage: %s\n", argv[0]);
-        return EXIT_FAILURE;
+        if (opt != 'f' || graphFileName != NULL)
+        {
+            fprintf(stderr, "Usage: %s [-f file] [Edge Edge Edge ...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        graphFileName = optarg;
     }
 
     // Setup the singal handler
@@ -57,11 +107,30 @@ int main(int argc, char *argv[])
     sigaction(SIGINT, &sa, NULL);
     sigaction(SIGTERM, &sa, NULL);
 
+    // load and publish the graph, the supervisor doesn't need its own copy
+    bool hasGraph = graphFileName != NULL || optind < argc;
+    if (hasGraph == true)
+    {
+        struct graph graph;
+        initGraph(&graph);
+
+        if (loadGraph(graphFileName, argc, argv, &graph) == -1 || publishGraph(&graph, SHM_GRAPH_NAME) == -1)
+        {
+            fprintf(stderr, "[%s] Error: Publishing the graph failed: %s\n", argv[0], strerror(errno));
+            freeGraph(&graph);
+            return EXIT_FAILURE;
+        }
+
+        freeGraph(&graph);
+    }
+
     // opening the circle buffer
-    struct circleBuffer *circleBuffer = openCircleBuffer(true);
+    struct circleBuffer *circleBuffer = openCircleBuffer(true, hasGraph);
     if (circleBuffer == NULL)
     {
         fprintf(stderr, "[%s] Error: Opening the circle-buffer failed: %s\n", argv[0], strerror(errno));
+        if (hasGraph == true)
+            unlinkGraph(SHM_GRAPH_NAME);
         return EXIT_FAILURE;
     }
 
@@ -71,15 +140,21 @@ int main(int argc, char *argv[])
     while (quit == false)
     {
         // Read a solution from the circular buffer
-        char *s = readCircleBuffer(circleBuffer);
-        if (s == NULL)
+        size_t length;
+        const struct solution *solution = readCircleBuffer(circleBuffer, &length);
+        if (solution == NULL)
             break;
 
-        // Read the first character, which is the length of this solution and
-        // convert it to an integer
-        int tmp_min = s[0] - '0';
+        // Ignore records, which are no complete solution
+        if (length < SOLUTION_SIZE(0) || solution->edgeCount > MAX_SOLUTION_LENGTH || length != SOLUTION_SIZE(solution->edgeCount))
+        {
+            releaseCircleBuffer(circleBuffer);
+            continue;
+        }
+
+        int tmp_min = solution->edgeCount;
 
-        // Print the solution, if its the best so far
+        // Print the solution, if its the best so far (only those are formatted)
         if (tmp_min < min || hasMin == true)
         {
             min = tmp_min;
@@ -87,7 +162,10 @@ int main(int argc, char *argv[])
 
             if (min > 0)
             {
-                printf("[%s] Solution with %d edges: %s\n", argv[0], min, &s[2]);
+                printf("[%s] Solution with %d edges:", argv[0], min);
+                for (int i = 0; i < min; i++)
+                    printf(" %" PRIu32 "-%" PRIu32, solution->vertices[2 * i], solution->vertices[2 * i + 1]);
+                printf("\n");
             }
             else
             {
@@ -97,10 +175,17 @@ int main(int argc, char *argv[])
             }
         }
 
-        free(s);
+        releaseCircleBuffer(circleBuffer);
+    }
+
+    // closing the circle buffer and removing the graph, the generators keep their mapping
+    if (hasGraph == true && unlinkGraph(SHM_GRAPH_NAME) == -1)
+    {
+        fprintf(stderr, "[%s] Error: Removing the graph failed: %s\n", argv[0], strerror(errno));
+        closeCircleBuffer(circleBuffer, true);
+        return EXIT_FAILURE;
     }
 
-    // closing the circle buffer
     if (closeCircleBuffer(circleBuffer, true) == -1)
     {
         fprintf(stderr, "[%s] Error: Closing the circle-buffer failed: %s\n", argv[0], strerror(errno));